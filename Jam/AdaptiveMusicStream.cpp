@@ -0,0 +1,140 @@
+#include "AdaptiveMusicStream.h"
+#include "ResourceCache.h"
+#include "MixKernels.h"
+#include <algorithm>
+#include <iostream>
+
+AdaptiveMusicStream::AdaptiveMusicStream() = default;
+
+AdaptiveMusicStream::~AdaptiveMusicStream()
+{
+    // The stream thread calls onGetData; stop it while the stems still exist
+    stop();
+}
+
+bool AdaptiveMusicStream::Open(const std::array<std::string, STEM_COUNT>& paths)
+{
+    stop();
+    unsigned sampleRate = 0;
+
+    for (std::size_t i = 0; i < STEM_COUNT; ++i) {
+        Stem& stem = m_stems[i];
+        // Keep the previous stream alive until the file has switched away from it
+        std::unique_ptr<sf::InputStream> next = ResourceCache::Shared().OpenPackStream(paths[i]);
+        const bool ok = next ? stem.file.openFromStream(*next) : stem.file.openFromFile(paths[i]);
+        stem.source = std::move(next);
+        if (!ok) {
+            std::cerr << "Warning: music stem could not be opened: " << paths[i] << std::endl;
+            return false;
+        }
+
+        stem.channels = stem.file.getChannelCount();
+        if (i == 0) sampleRate = stem.file.getSampleRate();
+        if (stem.file.getSampleRate() != sampleRate) {
+            std::cerr << "Warning: music stem " << paths[i] << " is " << stem.file.getSampleRate()
+                << " Hz, expected " << sampleRate << " Hz" << std::endl;
+            return false;
+        }
+        if (stem.channels != 1 && stem.channels != 2) {
+            std::cerr << "Warning: music stem " << paths[i] << " has " << stem.channels
+                << " channels, only mono and stereo are supported" << std::endl;
+            return false;
+        }
+    }
+
+    m_chunkFrames = std::max<std::size_t>(1, static_cast<std::size_t>(sampleRate * CHUNK_SECONDS));
+    for (Stem& stem : m_stems) stem.samples.resize(m_chunkFrames * stem.channels);
+    m_accum.resize(m_chunkFrames * m_channelCount);
+    m_mix.resize(m_chunkFrames * m_channelCount);
+    m_effects.Prepare(sampleRate);
+
+    initialize(m_channelCount, sampleRate);
+    return true;
+}
+
+void AdaptiveMusicStream::SetStemGain(std::size_t stem, float gain, bool immediate)
+{
+    if (stem >= STEM_COUNT) return;
+    gain = std::clamp(gain, 0.f, 1.f);
+    m_stems[stem].target.store(gain, std::memory_order_relaxed);
+    // The stream thread owns `gain` while it exists, which includes Paused
+    if (immediate && getStatus() == sf::SoundSource::Stopped) m_stems[stem].gain = gain;
+}
+
+void AdaptiveMusicStream::readStem(Stem& stem, std::size_t frames)
+{
+    sf::Int16* out = stem.samples.data();
+    std::size_t remaining = frames * stem.channels;
+    bool wrapped = false;
+    while (remaining > 0) {
+        const std::size_t got = static_cast<std::size_t>(stem.file.read(out, remaining));
+        out += got;
+        remaining -= got;
+        if (remaining == 0) break;
+        // End of this stem: loop it. A stem that yields nothing even from
+        // the start is silent rather than spinning here.
+        if (got == 0 && wrapped) {
+            std::fill(out, out + remaining, sf::Int16(0));
+            break;
+        }
+        stem.file.seek(0);
+        wrapped = (got == 0);
+    }
+}
+
+bool AdaptiveMusicStream::onGetData(Chunk& data)
+{
+    const std::size_t frames = m_chunkFrames;
+    const unsigned outChannels = m_channelCount;
+    std::fill(m_accum.begin(), m_accum.end(), 0.f);
+
+    for (Stem& stem : m_stems) {
+        // Every stem advances even when silent so they stay sample-aligned
+        readStem(stem, frames);
+
+        const float start = stem.gain;
+        const float end = stem.target.load(std::memory_order_relaxed);
+        stem.gain = end;
+        if (start <= 0.f && end <= 0.f) continue;
+
+        const float step = (end - start) / static_cast<float>(frames);
+        const float scale = 1.f / 32768.f;
+        const sf::Int16* in = stem.samples.data();
+        float* acc = m_accum.data();
+        float g = start;
+        if (stem.channels == outChannels) {
+            for (std::size_t f = 0; f < frames; ++f) {
+                g += step;
+                const float k = g * scale;
+                for (unsigned c = 0; c < outChannels; ++c)
+                    *acc++ += static_cast<float>(*in++) * k;
+            }
+        }
+        else {
+            // Mono stem under a wider mix
+            for (std::size_t f = 0; f < frames; ++f) {
+                g += step;
+                const float v = static_cast<float>(*in++) * g * scale;
+                for (unsigned c = 0; c < outChannels; ++c)
+                    *acc++ += v;
+            }
+        }
+    }
+
+    if (m_effects.Active()) m_effects.Process(m_accum.data(), frames);
+
+    MixKernels::FloatToInt16(m_mix.data(), m_accum.data(), m_accum.size());
+
+    data.samples = m_mix.data();
+    data.sampleCount = m_mix.size();
+    return true; // stems loop on their own, the stream never ends
+}
+
+void AdaptiveMusicStream::onSeek(sf::Time timeOffset)
+{
+    for (Stem& stem : m_stems) {
+        const sf::Int64 length = stem.file.getDuration().asMicroseconds();
+        const sf::Int64 offset = length > 0 ? timeOffset.asMicroseconds() % length : 0;
+        stem.file.seek(sf::microseconds(offset));
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include "BusEffects.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Plays several stems of one piece of music (e.g. the neutral and crazy
+// arrangements) as a single sf::SoundStream. Every stem is decoded in
+// lockstep on the stream's one thread and mixed with its own gain, so
+// switching between them is a gain change on an already aligned mix
+// rather than a second sf::Music starting from the top. Each stem loops on
+// its own length. The mix is always stereo and runs the Music bus's
+// insert effects.
+class AdaptiveMusicStream : public sf::SoundStream {
+public:
+    static constexpr std::size_t STEM_COUNT = 2;
+
+    AdaptiveMusicStream();
+    ~AdaptiveMusicStream() override;
+
+    // Stops playback. Streams from the mounted asset pack when a stem is in
+    // it, else from the loose file. Stems must share a sample rate and be
+    // mono or stereo; mono ones play on both channels.
+    bool Open(const std::array<std::string, STEM_COUNT>& paths);
+
+    // 0..1. Ramped across the next decoded chunk, so a change lands within
+    // a few chunks (CHUNK_SECONDS each) without clicks. `immediate` jumps,
+    // but only on a stopped stream; otherwise it ramps like any change.
+    void SetStemGain(std::size_t stem, float gain, bool immediate = false);
+    float StemGain(std::size_t stem) const { return m_stems[stem].target.load(std::memory_order_relaxed); }
+
+    static constexpr float CHUNK_SECONDS = 0.05f;
+
+    BusEffects& Effects() { return m_effects; }
+    const BusEffects& Effects() const { return m_effects; }
+
+protected:
+    bool onGetData(Chunk& data) override;
+    void onSeek(sf::Time timeOffset) override;
+
+private:
+    struct Stem {
+        std::unique_ptr<sf::InputStream> source; // pack stream; declared first so it outlives `file`
+        sf::InputSoundFile file;
+        std::vector<sf::Int16> samples;          // one chunk in the stem's own channel layout
+        unsigned channels = 0;
+        std::atomic<float> target{ 0.f };
+        float gain = 0.f;                        // stream thread: gain at the end of the last chunk
+    };
+
+    void readStem(Stem& stem, std::size_t frames);
+
+    std::array<Stem, STEM_COUNT> m_stems;
+    std::vector<float> m_accum;
+    std::vector<sf::Int16> m_mix;
+    BusEffects m_effects;
+    static constexpr unsigned m_channelCount = 2;
+    std::size_t m_chunkFrames = 0;
+};
@@ -1,103 +1,176 @@
 #include "Animation.h"
 
 Animation::Animation()
-    : m_currentFrameIndex(0),
-    m_accum(0.f),
-    m_sprite(nullptr),
-    m_facingRight(true)
+    : m_sprite(nullptr)
 {
 }
 
-bool Animation::AddClip(const std::string& name, const std::vector<std::string>& framePaths, float frameTimeSeconds, bool loop)
+Animation::ClipId Animation::AddClip(const std::string& name, const std::vector<std::string>& framePaths, float frameTimeSeconds, bool loop,
+    float bakeScale)
 {
-    Clip clip;
-    clip.frameTimeSeconds = frameTimeSeconds;
-    clip.loop = loop;
+    ClipRef clip = ClipLibrary::Shared().Load(framePaths, frameTimeSeconds, loop, bakeScale);
+    if (!clip) return INVALID_CLIP;
+    return AddClip(name, std::move(clip));
+}
 
-    clip.frames.reserve(framePaths.size());
-    for (const auto& path : framePaths) {
-        sf::Texture tex;
-        if (!tex.loadFromFile(path)) {
-            // If a frame fails to load, the entire clip is considered failed
-            return false;
-        }
-        tex.setSmooth(true);
-        clip.frames.emplace_back(std::move(tex));
+Animation::ClipId Animation::AddClip(const std::string& name, ClipRef clip)
+{
+    if (!clip) return INVALID_CLIP;
+
+    ClipTable& table = mutableTable();
+    ClipId id = FindClip(name);
+    if (id == INVALID_CLIP) {
+        id = static_cast<ClipId>(table.clips.size());
+        table.clips.push_back(std::move(clip));
+        table.names.push_back(name);
+        table.ids.emplace(name, id);
+    }
+    else {
+        table.clips[id] = std::move(clip);
     }
-
-    m_clips[name] = std::move(clip);
 
     // If no current clip, set this one as default
-    if (m_currentClipName.empty()) {
-        SetClip(name, true);
+    if (m_state.clip == INVALID_CLIP) {
+        SetClip(id, true);
     }
 
-    return true;
+    return id;
 }
 
-bool Animation::SetClip(const std::string& name, bool resetFrameIndex)
+void Animation::ShareClipsWith(const Animation& other)
 {
-    auto it = m_clips.find(name);
-    if (it == m_clips.end()) return false;
+    m_table = other.m_table;
+    m_state.clip = INVALID_CLIP;
+    m_state.frame = 0;
+    m_state.accum = 0.f;
+    m_state.finished = false;
+    m_callbacks.clear();
+}
+
+Animation::ClipTable& Animation::mutableTable()
+{
+    // Copy on write so instances sharing a table never see each other's additions
+    if (!m_table) m_table = std::make_shared<ClipTable>();
+    else if (m_table.use_count() > 1) m_table = std::make_shared<ClipTable>(*m_table);
+    return *m_table;
+}
 
-    m_currentClipName = name;
+Animation::ClipId Animation::FindClip(const std::string& name) const
+{
+    if (!m_table) return INVALID_CLIP;
+    auto it = m_table->ids.find(name);
+    return it == m_table->ids.end() ? INVALID_CLIP : it->second;
+}
+
+const std::string& Animation::ClipName(ClipId id) const
+{
+    static const std::string empty;
+    if (!m_table || id < 0 || id >= static_cast<ClipId>(m_table->names.size())) return empty;
+    return m_table->names[id];
+}
+
+const AnimationClip* Animation::currentClip() const
+{
+    if (!m_table || m_state.clip < 0 || m_state.clip >= static_cast<ClipId>(m_table->clips.size())) return nullptr;
+    return m_table->clips[m_state.clip].get();
+}
+
+bool Animation::SetClip(ClipId id, bool resetFrameIndex)
+{
+    if (!m_table || id < 0 || id >= static_cast<ClipId>(m_table->clips.size())) return false;
+
+    m_state.clip = id;
+    m_state.finished = false;
     if (resetFrameIndex) {
-        m_currentFrameIndex = 0;
-        m_accum = 0.f;
-        applyFrame();
+        m_state.frame = 0;
+        m_state.accum = 0.f;
     }
-    else {
-        applyFrame();
+    else if (m_state.frame >= m_table->clips[id]->frames.size()) {
+        m_state.frame = 0;
     }
+    applyFrame();
     return true;
 }
 
 void Animation::Update(float dt)
 {
-    if (m_currentClipName.empty()) return;
-    auto it = m_clips.find(m_currentClipName);
-    if (it == m_clips.end()) return;
-
-    Clip& clip = it->second;
-    if (clip.frames.empty()) return;
-
-    m_accum += dt;
-    while (m_accum >= clip.frameTimeSeconds) {
-        m_accum -= clip.frameTimeSeconds;
-        if (m_currentFrameIndex + 1 < clip.frames.size()) {
-            m_currentFrameIndex++;
+    const AnimationClip* current = currentClip();
+    if (!current || current->frames.empty() || m_state.finished) return;
+    const AnimationClip& clip = *current;
+    const ClipId clipId = m_state.clip;
+
+    m_state.accum += dt;
+    while (m_state.accum >= clip.frameTimeSeconds) {
+        m_state.accum -= clip.frameTimeSeconds;
+
+        bool wrapped = false;
+        if (m_state.frame + 1 < clip.frames.size()) {
+            m_state.frame++;
+        }
+        else if (clip.loop) {
+            m_state.frame = 0;
+            wrapped = true;
         }
         else {
-            if (clip.loop) {
-                m_currentFrameIndex = 0;
-            }
-            else {
-                // stay on last frame if not looping
-            }
+            // stay on last frame if not looping
+            m_state.finished = true;
+            m_state.accum = 0.f;
+            if (ClipCallbacks* cb = callbacksFor(clipId); cb && cb->onFinished) cb->onFinished();
+            return;
         }
+
         applyFrame();
+
+        // Looked up again after each call: a callback may register callbacks or switch clips
+        if (wrapped) {
+            if (ClipCallbacks* cb = callbacksFor(clipId); cb && cb->onFinished) cb->onFinished();
+            if (m_state.clip != clipId) return;
+        }
+        if (ClipCallbacks* cb = callbacksFor(clipId); cb && cb->onFrame) cb->onFrame(m_state.frame);
+        if (m_state.clip != clipId) return;
     }
 }
 
+void Animation::SetFrameCallback(ClipId id, FrameCallback callback)
+{
+    if (id < 0) return;
+    if (m_callbacks.size() <= static_cast<std::size_t>(id)) m_callbacks.resize(id + 1);
+    m_callbacks[id].onFrame = std::move(callback);
+}
+
+void Animation::SetFinishedCallback(ClipId id, FinishedCallback callback)
+{
+    if (id < 0) return;
+    if (m_callbacks.size() <= static_cast<std::size_t>(id)) m_callbacks.resize(id + 1);
+    m_callbacks[id].onFinished = std::move(callback);
+}
+
+Animation::ClipCallbacks* Animation::callbacksFor(ClipId id)
+{
+    if (id < 0 || static_cast<std::size_t>(id) >= m_callbacks.size()) return nullptr;
+    return &m_callbacks[id];
+}
+
 void Animation::BindSprite(sf::Sprite* sprite)
 {
     m_sprite = sprite;
     applyFrame();
     // Apply facing scale
-    if (m_sprite) m_sprite->setScale(m_facingRight ? 1.f : -1.f, 1.f);
+    if (m_sprite) m_sprite->setScale(m_state.facingRight ? 1.f : -1.f, 1.f);
 }
 
 void Animation::Reset()
 {
-    m_accum = 0.f;
-    m_currentFrameIndex = 0;
+    m_state.accum = 0.f;
+    m_state.frame = 0;
+    m_state.finished = false;
     applyFrame();
 }
 
 void Animation::SetFacingRight(bool right)
 {
-    if (m_facingRight == right) return;
-    m_facingRight = right;
+    if (m_state.facingRight == right) return;
+    m_state.facingRight = right;
     if (m_sprite) {
         sf::Vector2f s = m_sprite->getScale();
         m_sprite->setScale(right ? std::abs(s.x) : -std::abs(s.x), s.y);
@@ -106,26 +179,28 @@ void Animation::SetFacingRight(bool right)
 
 std::size_t Animation::CurrentFrameCount() const
 {
-    auto it = m_clips.find(m_currentClipName);
-    if (it == m_clips.end()) return 0;
-    return it->second.frames.size();
+    const AnimationClip* clip = currentClip();
+    return clip ? clip->frames.size() : 0;
 }
 
 void Animation::applyFrame()
 {
     if (!m_sprite) return;
-    auto it = m_clips.find(m_currentClipName);
-    if (it == m_clips.end()) return;
-    Clip& clip = it->second;
-    if (clip.frames.empty()) return;
+    const AnimationClip* current = currentClip();
+    if (!current || current->frames.empty()) return;
+    const AnimationClip& clip = *current;
 
-    m_sprite->setTexture(clip.frames[m_currentFrameIndex], true);
+    // Only rebind when the frame lives on another page; otherwise it is just a rect change
+    const AnimationFrame& frame = clip.frames[m_state.frame];
+    const sf::Texture* page = clip.pages[frame.page].get();
+    if (m_sprite->getTexture() != page)
+        m_sprite->setTexture(*page);
+    m_sprite->setTextureRect(frame.rect);
 
-    // Keep origin centered to make horizontal flip stable
-    const sf::Vector2u size = clip.frames[m_currentFrameIndex].getSize();
-    m_sprite->setOrigin(static_cast<float>(size.x) / 2.f, static_cast<float>(size.y) / 2.f);
+    // Per-frame pivot (frame centre for packed clips) keeps the horizontal flip stable
+    m_sprite->setOrigin(frame.pivot);
 
     // Re-apply facing scale in case texture size change affects appearance
     sf::Vector2f s = m_sprite->getScale();
-    m_sprite->setScale(m_facingRight ? std::abs(s.x) : -std::abs(s.x), s.y);
+    m_sprite->setScale(m_state.facingRight ? std::abs(s.x) : -std::abs(s.x), s.y);
 }
\ No newline at end of file
@@ -2,29 +2,67 @@
 #define ANIMATION_H
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include "ClipLibrary.h"
+
+// Per-instance playback state; everything else an Animation uses is shared
+struct AnimationState {
+    std::int32_t clip = -1;
+    std::uint32_t frame = 0;
+    float accum = 0.f; // seconds
+    bool facingRight = true;
+    bool finished = false; // non-looping clip has shown its last frame for a full frame time
+};
 
 class Animation {
 public:
-    struct Clip {
-        std::vector<sf::Texture> frames;
-        float frameTimeSeconds = 0.1f; // default per-frame time
-        bool loop = true;
-    };
+    // Index of a clip inside one Animation, resolved once when the clip is added
+    using ClipId = std::int32_t;
+    static constexpr ClipId INVALID_CLIP = -1;
 
     Animation();
 
-    // Create a clip and load frames from file paths
-    bool AddClip(const std::string& name, const std::vector<std::string>& framePaths, float frameTimeSeconds, bool loop);
+    // Create a clip and load frames from file paths (through ClipLibrary, so
+    // frames already loaded by another Animation are reused).
+    // Returns the clip's id, or INVALID_CLIP if a frame failed to load.
+    // Adding a name that already exists replaces that clip and keeps its id.
+    // `bakeScale` is passed on to ClipLibrary::Load.
+    ClipId AddClip(const std::string& name, const std::vector<std::string>& framePaths, float frameTimeSeconds, bool loop,
+        float bakeScale = 1.f);
+    ClipId AddClip(const std::string& name, ClipRef clip);
+
+    // Reuse another Animation's clip table (same ids); state is not copied.
+    // A later AddClip on either side detaches it first.
+    void ShareClipsWith(const Animation& other);
 
     // Switch current clip
-    bool SetClip(const std::string& name, bool resetFrameIndex = true);
+    bool SetClip(ClipId id, bool resetFrameIndex = true);
+
+    // Name-based lookup, meant for tooling and one-off setup rather than per-frame use
+    ClipId FindClip(const std::string& name) const;
+    bool SetClip(const std::string& name, bool resetFrameIndex = true) { return SetClip(FindClip(name), resetFrameIndex); }
+    const std::string& ClipName(ClipId id) const;
 
-    // Advance animation time and update sprite texture
+    // Advance animation time and update sprite texture.
+    // Fires the current clip's frame/finished callbacks.
     void Update(float dt);
 
+    // Per-instance callbacks for one clip, fired from Update.
+    // Frame: every time the displayed frame changes (including a loop wrap to 0).
+    // Finished: once when a non-looping clip has held its last frame for one
+    // frame time, or at every wrap of a looping clip.
+    // Callbacks may switch clips; Update stops advancing the old clip if they do.
+    using FrameCallback = std::function<void(std::size_t frame)>;
+    using FinishedCallback = std::function<void()>;
+    void SetFrameCallback(ClipId id, FrameCallback callback);
+    void SetFinishedCallback(ClipId id, FinishedCallback callback);
+    bool IsFinished() const { return m_state.finished; }
+
     // Bind a sprite to this animation for texture swapping
     void BindSprite(sf::Sprite* sprite);
 
@@ -33,23 +71,38 @@ public:
 
     // Facing helpers (does not change origin, only scale)
     void SetFacingRight(bool right);
-    bool IsFacingRight() const { return m_facingRight; }
+    bool IsFacingRight() const { return m_state.facingRight; }
 
     // Accessors
-    const std::string& CurrentClip() const { return m_currentClipName; }
-    std::size_t CurrentFrameIndex() const { return m_currentFrameIndex; }
+    ClipId CurrentClipId() const { return m_state.clip; }
+    const std::string& CurrentClip() const { return ClipName(m_state.clip); }
+    std::size_t CurrentFrameIndex() const { return m_state.frame; }
     std::size_t CurrentFrameCount() const;
+    const AnimationState& State() const { return m_state; }
 
 private:
+    // Clip references plus the name table; shared between instances until modified
+    struct ClipTable {
+        std::vector<ClipRef> clips;                         // indexed by ClipId
+        std::vector<std::string> names;                     // indexed by ClipId
+        std::unordered_map<std::string, ClipId> ids;        // name -> id, only used by the string API
+    };
+
+    struct ClipCallbacks {
+        FrameCallback onFrame;
+        FinishedCallback onFinished;
+    };
+
     void applyFrame();
+    const AnimationClip* currentClip() const;
+    ClipTable& mutableTable();
+    ClipCallbacks* callbacksFor(ClipId id);
 
 private:
-    std::unordered_map<std::string, Clip> m_clips;
-    std::string m_currentClipName;
-    std::size_t m_currentFrameIndex;
-    float m_accum; // seconds
+    std::shared_ptr<ClipTable> m_table;
+    AnimationState m_state;
     sf::Sprite* m_sprite;
-    bool m_facingRight;
+    std::vector<ClipCallbacks> m_callbacks; // indexed by ClipId, empty unless callbacks are set
 };
 
 #endif // ANIMATION_H
\ No newline at end of file
@@ -0,0 +1,278 @@
+#include "AnimationBenchmark.h"
+#include "Animation.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr std::size_t ENTITY_COUNT = 1000;
+    constexpr int FRAMES = 2000;
+    constexpr int REPEATS = 3;            // best of, to keep scheduler noise out
+    constexpr float DT = 1.f / 60.f;
+    constexpr std::uint32_t CHANGE_ONE_IN = 8; // chance per entity and frame of a new input
+    constexpr std::size_t BATCH_COUNT = 10000;
+    constexpr int BATCH_FRAMES = 1000;
+
+    // Same shape as Player's locomotion table: [psycho][air, idle, walk, run]
+    constexpr int MOVE_COUNT = 4;
+    const char* const kClipNames[2][MOVE_COUNT] = {
+        { "Jump",      "Idle",      "Walk",      "Run" },
+        { "AngryJump", "AngryIdle", "AngryWalk", "AngryRun" },
+    };
+    constexpr int kFrameCounts[MOVE_COUNT] = { 6, 1, 7, 8 };
+
+    struct Result {
+        const char* scenario;
+        const char* variant;
+        std::size_t entities = 0;
+        float microsPerFrame = 0.f;
+        std::uint64_t changes = 0; // clip switches, or frame steps for the batch rows
+    };
+
+    // Clip per name, all on one sheet page
+    Animation makePrototype(Animation::ClipId (&ids)[2][MOVE_COUNT], ClipRef (&clips)[2][MOVE_COUNT])
+    {
+        auto page = std::make_shared<sf::Texture>();
+        Animation prototype;
+        for (int psycho = 0; psycho < 2; ++psycho) {
+            for (int move = 0; move < MOVE_COUNT; ++move) {
+                auto clip = std::make_shared<AnimationClip>();
+                clip->pages.push_back(page);
+                clip->frameTimeSeconds = move == 1 ? 0.2f : 0.08f;
+                clip->loop = move != 0;
+                for (int f = 0; f < kFrameCounts[move]; ++f) {
+                    AnimationFrame frame;
+                    frame.rect = sf::IntRect(f * 64, (psycho * MOVE_COUNT + move) * 96, 64, 96);
+                    frame.pivot = sf::Vector2f(32.f, 48.f);
+                    clip->frames.push_back(frame);
+                }
+                clips[psycho][move] = clip;
+                ids[psycho][move] = prototype.AddClip(kClipNames[psycho][move], std::move(clip));
+            }
+        }
+        return prototype;
+    }
+
+    // Input per frame and entity, packed as psycho * MOVE_COUNT + move
+    std::vector<std::uint8_t> makeInputs(bool changing)
+    {
+        std::vector<std::uint8_t> inputs(ENTITY_COUNT * FRAMES);
+        std::uint32_t seed = 0x9E3779B9u;
+        const auto next = [&seed] { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+        for (std::size_t e = 0; e < ENTITY_COUNT; ++e) {
+            std::uint8_t input = changing ? static_cast<std::uint8_t>(next() % (2 * MOVE_COUNT)) : 3;
+            for (int f = 0; f < FRAMES; ++f) {
+                if (changing && next() % CHANGE_ONE_IN == 0) input = static_cast<std::uint8_t>(next() % (2 * MOVE_COUNT));
+                inputs[f * ENTITY_COUNT + e] = input;
+            }
+        }
+        return inputs;
+    }
+
+    template <typename Step>
+    Result measure(const char* scenario, const char* lookup, const Animation& prototype,
+        const std::vector<std::uint8_t>& inputs, Step step)
+    {
+        Result r{ scenario, lookup, ENTITY_COUNT };
+        float best = -1.f;
+        for (int repeat = 0; repeat < REPEATS; ++repeat) {
+            std::vector<sf::Sprite> sprites(ENTITY_COUNT);
+            std::vector<Animation> anims(ENTITY_COUNT);
+            for (std::size_t e = 0; e < ENTITY_COUNT; ++e) {
+                anims[e].ShareClipsWith(prototype);
+                anims[e].BindSprite(&sprites[e]);
+            }
+
+            std::uint64_t switches = 0;
+            sf::Clock clock;
+            for (int f = 0; f < FRAMES; ++f) {
+                const std::uint8_t* frameInputs = &inputs[static_cast<std::size_t>(f) * ENTITY_COUNT];
+                for (std::size_t e = 0; e < ENTITY_COUNT; ++e)
+                    switches += step(anims[e], frameInputs[e] / MOVE_COUNT, frameInputs[e] % MOVE_COUNT);
+            }
+            const float micros = static_cast<float>(clock.getElapsedTime().asMicroseconds()) / FRAMES;
+            if (best < 0.f || micros < best) best = micros;
+            r.changes = switches;
+        }
+        r.microsPerFrame = best;
+        return r;
+    }
+
+    // Looping clip and start offset per entity, so frame changes are spread
+    // over the batch instead of landing on the same tick
+    struct BatchSetup {
+        std::vector<std::uint8_t> clip; // psycho * MOVE_COUNT + move, move never 0 (jump)
+        std::vector<float> offset;      // seconds, below the clip's frame time
+    };
+
+    BatchSetup makeBatch(const ClipRef (&clips)[2][MOVE_COUNT])
+    {
+        BatchSetup setup;
+        std::uint32_t seed = 0x2545F491u;
+        const auto next = [&seed] { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+        for (std::size_t e = 0; e < BATCH_COUNT; ++e) {
+            const std::uint8_t clip = static_cast<std::uint8_t>((next() % 2) * MOVE_COUNT + 1 + next() % (MOVE_COUNT - 1));
+            const float frameTime = clips[clip / MOVE_COUNT][clip % MOVE_COUNT]->frameTimeSeconds;
+            setup.clip.push_back(clip);
+            setup.offset.push_back(frameTime * static_cast<float>(next() % 1024) / 1024.f);
+        }
+        return setup;
+    }
+
+    // Same sprite writes as Animation::applyFrame
+    void writeFrame(sf::Sprite& sprite, const AnimationClip& clip, std::uint32_t frame)
+    {
+        const AnimationFrame& f = clip.frames[frame];
+        const sf::Texture* page = clip.pages[f.page].get();
+        if (sprite.getTexture() != page)
+            sprite.setTexture(*page);
+        sprite.setTextureRect(f.rect);
+        sprite.setOrigin(f.pivot);
+        const sf::Vector2f s = sprite.getScale();
+        sprite.setScale(std::abs(s.x), s.y);
+    }
+
+    // One Animation per entity, as Player and World hold them
+    Result measureObjects(const Animation& prototype, const Animation::ClipId (&ids)[2][MOVE_COUNT], const BatchSetup& setup)
+    {
+        Result r{ "batch", "Animation", BATCH_COUNT };
+        float best = -1.f;
+        for (int repeat = 0; repeat < REPEATS; ++repeat) {
+            std::vector<sf::Sprite> sprites(BATCH_COUNT);
+            std::vector<Animation> anims(BATCH_COUNT);
+            for (std::size_t e = 0; e < BATCH_COUNT; ++e) {
+                anims[e].ShareClipsWith(prototype);
+                anims[e].BindSprite(&sprites[e]);
+                anims[e].SetClip(ids[setup.clip[e] / MOVE_COUNT][setup.clip[e] % MOVE_COUNT], true);
+                anims[e].Update(setup.offset[e]);
+            }
+
+            std::uint64_t steps = 0;
+            sf::Clock clock;
+            for (int f = 0; f < BATCH_FRAMES; ++f) {
+                for (Animation& anim : anims) {
+                    const float before = anim.State().accum;
+                    anim.Update(DT);
+                    steps += anim.State().accum < before;
+                }
+            }
+            const float micros = static_cast<float>(clock.getElapsedTime().asMicroseconds()) / BATCH_FRAMES;
+            if (best < 0.f || micros < best) best = micros;
+            r.changes = steps;
+        }
+        r.microsPerFrame = best;
+        return r;
+    }
+
+    // Structure-of-arrays alternative: playback state in parallel arrays,
+    // advanced in one branch-free pass, then sprite writes only for entities
+    // whose frame moved. Every batch clip loops and DT is below the shortest
+    // frame time, so one step per tick at most is enough here.
+    Result measureArrays(const ClipRef (&clips)[2][MOVE_COUNT], const BatchSetup& setup)
+    {
+        Result r{ "batch", "arrays", BATCH_COUNT };
+        float best = -1.f;
+        for (int repeat = 0; repeat < REPEATS; ++repeat) {
+            std::vector<sf::Sprite> sprites(BATCH_COUNT);
+            std::vector<const AnimationClip*> clip(BATCH_COUNT);
+            std::vector<float> accum(BATCH_COUNT), frameTime(BATCH_COUNT);
+            std::vector<std::uint32_t> frame(BATCH_COUNT, 0), frameCount(BATCH_COUNT);
+            std::vector<std::uint8_t> stepped(BATCH_COUNT);
+            for (std::size_t e = 0; e < BATCH_COUNT; ++e) {
+                clip[e] = clips[setup.clip[e] / MOVE_COUNT][setup.clip[e] % MOVE_COUNT].get();
+                accum[e] = setup.offset[e];
+                frameTime[e] = clip[e]->frameTimeSeconds;
+                frameCount[e] = static_cast<std::uint32_t>(clip[e]->frames.size());
+                writeFrame(sprites[e], *clip[e], 0);
+            }
+
+            std::uint64_t steps = 0;
+            sf::Clock clock;
+            for (int f = 0; f < BATCH_FRAMES; ++f) {
+                for (std::size_t e = 0; e < BATCH_COUNT; ++e) {
+                    const float a = accum[e] + DT;
+                    const bool step = a >= frameTime[e];
+                    const std::uint32_t n = frame[e] + step;
+                    accum[e] = step ? a - frameTime[e] : a;
+                    frame[e] = n == frameCount[e] ? 0 : n;
+                    stepped[e] = step;
+                }
+                for (std::size_t e = 0; e < BATCH_COUNT; ++e) {
+                    if (!stepped[e]) continue;
+                    writeFrame(sprites[e], *clip[e], frame[e]);
+                    ++steps;
+                }
+            }
+            const float micros = static_cast<float>(clock.getElapsedTime().asMicroseconds()) / BATCH_FRAMES;
+            if (best < 0.f || micros < best) best = micros;
+            r.changes = steps;
+        }
+        r.microsPerFrame = best;
+        return r;
+    }
+}
+
+namespace AnimationBenchmark {
+
+bool Run(const std::string& csvPath)
+{
+    Animation::ClipId ids[2][MOVE_COUNT];
+    ClipRef clips[2][MOVE_COUNT];
+    const Animation prototype = makePrototype(ids, clips);
+
+    // What Player::Update did before clip ids: a name per frame, compared
+    // against the current clip's and looked up on a change
+    const auto byName = [](Animation& anim, int psycho, int move) -> int {
+        const std::string desired = kClipNames[psycho][move];
+        const bool change = anim.CurrentClip() != desired;
+        if (change) anim.SetClip(desired, true);
+        anim.Update(DT);
+        return change;
+    };
+    const auto byId = [&ids](Animation& anim, int psycho, int move) -> int {
+        const Animation::ClipId desired = ids[psycho][move];
+        const bool change = anim.CurrentClipId() != desired;
+        if (change) anim.SetClip(desired, true);
+        anim.Update(DT);
+        return change;
+    };
+
+    std::vector<Result> results;
+    for (bool changing : { true, false }) {
+        const std::vector<std::uint8_t> inputs = makeInputs(changing);
+        const char* scenario = changing ? "changing" : "steady";
+        results.push_back(measure(scenario, "name", prototype, inputs, byName));
+        results.push_back(measure(scenario, "ClipId", prototype, inputs, byId));
+    }
+    const BatchSetup batch = makeBatch(clips);
+    results.push_back(measureObjects(prototype, ids, batch));
+    results.push_back(measureArrays(clips, batch));
+
+    std::cout << "Animation benchmark: " << FRAMES << " frames (" << BATCH_FRAMES << " for batch), best of " << REPEATS << "\n"
+        << "scenario  variant    entities  us/frame  changes\n";
+    for (const Result& r : results) {
+        std::cout << std::left << std::setw(10) << r.scenario << std::setw(11) << r.variant << std::right
+            << std::setw(8) << r.entities << std::fixed << std::setprecision(1) << std::setw(10) << r.microsPerFrame
+            << std::setw(9) << r.changes << "\n";
+    }
+    std::cout << std::flush;
+
+    std::ofstream csv(csvPath);
+    if (!csv) {
+        std::cerr << "Warning: could not write animation benchmark to " << csvPath << std::endl;
+        return false;
+    }
+    csv << "scenario,variant,entities,us_per_frame,changes\n";
+    for (const Result& r : results)
+        csv << r.scenario << ',' << r.variant << ',' << r.entities << ',' << r.microsPerFrame << ',' << r.changes << '\n';
+    return true;
+}
+
+}
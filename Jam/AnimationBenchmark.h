@@ -0,0 +1,15 @@
+#pragma once
+#include <string>
+
+// Benchmark (--animation-benchmark): per-frame cost of driving 1,000
+// Animations the way Player does, picking the clip by name (a std::string
+// per entity per frame, compared and looked up in the name table) against
+// picking it by ClipId. Both run the same input sequence, once with
+// entities changing state and once holding one clip. Sprites are real, so
+// the rect/origin writes on frame changes are in both figures. A second
+// case plays looping clips on 10,000 entities, once through one Animation
+// each and once from parallel state arrays that write the sprite only when
+// the frame moved. Prints a table and writes the rows to `csvPath`.
+namespace AnimationBenchmark {
+    bool Run(const std::string& csvPath);
+}
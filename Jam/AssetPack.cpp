@@ -0,0 +1,194 @@
+#include "AssetPack.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace AssetPackFormat;
+
+// ------------------------------------------------------------
+//  MappedFile
+// ------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+#ifdef _WIN32
+    HANDLE file = CreateFileW(std::filesystem::path(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const std::uint8_t*>(view);
+    m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps the file referenced
+    if (view == MAP_FAILED) return false;
+
+    m_data = static_cast<const std::uint8_t*>(view);
+    m_size = static_cast<std::size_t>(st.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(m_mapping);
+    if (m_file) CloseHandle(m_file);
+    m_mapping = nullptr;
+    m_file = nullptr;
+#else
+    if (m_data) munmap(const_cast<std::uint8_t*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
+// ------------------------------------------------------------
+//  AssetPack
+// ------------------------------------------------------------
+bool AssetPack::Mount(const std::string& path)
+{
+    Unmount();
+    if (!m_file.Open(path)) return false;
+
+    const std::uint8_t* base = m_file.Data();
+    const std::size_t size = m_file.Size();
+
+    PackHeader header;
+    if (size < sizeof(header)) {
+        std::cerr << "Warning: asset pack too small: " << path << "\n";
+        m_file.Close();
+        return false;
+    }
+    std::memcpy(&header, base, sizeof(header));
+
+    const std::uint64_t indexEnd = sizeof(PackHeader) + static_cast<std::uint64_t>(header.entryCount) * sizeof(PackEntry);
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        indexEnd > size || header.namesOffset < indexEnd ||
+        header.namesOffset > size || header.namesSize > size - header.namesOffset) {
+        std::cerr << "Warning: not a valid asset pack (or wrong version): " << path << "\n";
+        m_file.Close();
+        return false;
+    }
+
+    const auto* entries = reinterpret_cast<const PackEntry*>(base + sizeof(PackHeader));
+    for (std::uint32_t i = 0; i < header.entryCount; ++i) {
+        const PackEntry& e = entries[i];
+        // Compared without adding, so a corrupt offset cannot wrap past the checks
+        if (e.offset > size || e.size > size - e.offset ||
+            e.nameOffset > header.namesSize || e.nameSize > header.namesSize - e.nameOffset) {
+            std::cerr << "Warning: asset pack index out of range: " << path << "\n";
+            m_file.Close();
+            return false;
+        }
+    }
+
+    m_entries = entries;
+    m_entryCount = header.entryCount;
+    m_names = reinterpret_cast<const char*>(base + header.namesOffset);
+    std::error_code ec;
+    const auto mtime = std::filesystem::last_write_time(path, ec);
+    m_mtime = ec ? 0 : static_cast<std::int64_t>(mtime.time_since_epoch().count());
+    return true;
+}
+
+void AssetPack::Unmount()
+{
+    m_entries = nullptr;
+    m_entryCount = 0;
+    m_names = nullptr;
+    m_mtime = 0;
+    m_file.Close();
+}
+
+PackBlob AssetPack::Find(const std::string& path) const
+{
+    if (!IsMounted()) return {};
+    return FindNormalized(NormalizePath(path));
+}
+
+PackBlob AssetPack::FindNormalized(const std::string& key) const
+{
+    if (!IsMounted()) return {};
+
+    const std::uint64_t hash = HashPath(key);
+    const PackEntry* end = m_entries + m_entryCount;
+    const PackEntry* it = std::lower_bound(m_entries, end, hash,
+        [](const PackEntry& e, std::uint64_t h) { return e.hash < h; });
+
+    // Entries with equal hashes are adjacent; compare names to rule out collisions
+    for (; it != end && it->hash == hash; ++it) {
+        if (it->nameSize != key.size() || std::memcmp(m_names + it->nameOffset, key.data(), key.size()) != 0)
+            continue;
+        PackBlob blob{ m_file.Data() + it->offset, static_cast<std::size_t>(it->size) };
+        if (m_mtime != 0) {
+            const std::int64_t parts[2] = { m_mtime, static_cast<std::int64_t>(it->offset) };
+            blob.stamp = static_cast<std::int64_t>(HashBytes(parts, sizeof(parts)) | 1);
+        }
+        return blob;
+    }
+    return {};
+}
+
+// ------------------------------------------------------------
+//  PackStream
+// ------------------------------------------------------------
+sf::Int64 PackStream::read(void* data, sf::Int64 size)
+{
+    const sf::Int64 count = std::min(size, m_size - m_position);
+    if (count <= 0) return 0;
+    std::memcpy(data, m_data + m_position, static_cast<std::size_t>(count));
+    m_position += count;
+    return count;
+}
+
+sf::Int64 PackStream::seek(sf::Int64 position)
+{
+    if (position < 0 || position > m_size) return -1;
+    m_position = position;
+    return m_position;
+}
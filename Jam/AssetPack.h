@@ -0,0 +1,85 @@
+#pragma once
+#include <SFML/System/InputStream.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "AssetPackFormat.h"
+
+// Read-only memory mapping of a whole file (Win32 file mapping or POSIX mmap)
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return m_data != nullptr; }
+    const std::uint8_t* Data() const { return m_data; }
+    std::size_t Size() const { return m_size; }
+
+private:
+#ifdef _WIN32
+    void* m_file = nullptr;     // HANDLE
+    void* m_mapping = nullptr;  // HANDLE
+#endif
+    const std::uint8_t* m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+// A file stored in the pack: a view into the mapping, valid while the pack is mounted
+struct PackBlob {
+    const void* data = nullptr;
+    std::size_t size = 0;
+    // The pack's mtime mixed with the entry's offset: the same until the
+    // pack is rebuilt, so caches can key packed sources without hashing them.
+    // 0 if the pack's mtime is unknown.
+    std::int64_t stamp = 0;
+
+    explicit operator bool() const { return data != nullptr; }
+};
+
+// Assets.pak mounted through a memory mapping. Lookups are a binary search
+// over the hash-sorted index; nothing is read until a blob is decoded.
+class AssetPack {
+public:
+    // Returns false (without warning) if the file does not exist, and warns
+    // if it exists but is not a valid pack
+    bool Mount(const std::string& path);
+    void Unmount();
+
+    bool IsMounted() const { return m_entries != nullptr; }
+    PackBlob Find(const std::string& path) const;
+    PackBlob FindNormalized(const std::string& key) const;
+
+    std::size_t EntryCount() const { return m_entryCount; }
+    std::size_t MappedBytes() const { return m_file.Size(); }
+
+private:
+    MappedFile m_file;
+    const AssetPackFormat::PackEntry* m_entries = nullptr;
+    std::uint32_t m_entryCount = 0;
+    const char* m_names = nullptr;
+    std::int64_t m_mtime = 0;
+};
+
+// sf::InputStream over a pack blob, so SFML decoders (images, sound
+// files, music) read straight from the mapping instead of a file handle
+class PackStream : public sf::InputStream {
+public:
+    explicit PackStream(const PackBlob& blob)
+        : m_data(static_cast<const std::uint8_t*>(blob.data)), m_size(static_cast<sf::Int64>(blob.size)) {}
+
+    sf::Int64 read(void* data, sf::Int64 size) override;
+    sf::Int64 seek(sf::Int64 position) override;
+    sf::Int64 tell() override { return m_position; }
+    sf::Int64 getSize() override { return m_size; }
+
+private:
+    const std::uint8_t* m_data;
+    sf::Int64 m_size;
+    sf::Int64 m_position = 0;
+};
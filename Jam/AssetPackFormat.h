@@ -0,0 +1,76 @@
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// On-disk layout of Assets.pak, shared by the game and Tools/AssetPacker.
+// All integers are little-endian.
+//
+//   PackHeader
+//   PackEntry[entryCount]      sorted by hash, then name
+//   names                      normalised paths, not terminated
+//   blobs                      each starts on a BLOB_ALIGNMENT boundary
+namespace AssetPackFormat {
+
+    constexpr char MAGIC[4] = { 'J', 'P', 'A', 'K' };
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::uint32_t BLOB_ALIGNMENT = 64; // cache line; also keeps decoders' reads aligned
+
+    struct PackHeader {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t entryCount;
+        std::uint32_t blobAlignment;
+        std::uint64_t namesOffset;
+        std::uint64_t namesSize;
+    };
+    static_assert(sizeof(PackHeader) == 32, "PackHeader layout is part of the file format");
+
+    struct PackEntry {
+        std::uint64_t hash;        // HashPath of the normalised name
+        std::uint64_t offset;      // from the start of the file
+        std::uint64_t size;
+        std::uint32_t nameOffset;  // into the names block
+        std::uint32_t nameSize;
+    };
+    static_assert(sizeof(PackEntry) == 32, "PackEntry layout is part of the file format");
+
+    // Lower-case, '/' separators, "." and ".." resolved. Asset paths are
+    // case-insensitive on the platforms we ship, and the code base spells
+    // "Assets"/"assets" both ways.
+    inline std::string NormalizePath(const std::string& path)
+    {
+        std::string slashed = path;
+        std::replace(slashed.begin(), slashed.end(), '\\', '/'); // not a separator outside Windows
+        std::string key = std::filesystem::path(slashed).lexically_normal().generic_string();
+        std::transform(key.begin(), key.end(), key.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return key;
+    }
+
+    // FNV-1a, 64-bit. Pass the previous result as `h` to hash in pieces.
+    constexpr std::uint64_t HASH_SEED = 14695981039346656037ull;
+
+    inline std::uint64_t HashBytes(const void* data, std::size_t size, std::uint64_t h = HASH_SEED)
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            h ^= bytes[i];
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    inline std::uint64_t HashPath(const std::string& normalized)
+    {
+        return HashBytes(normalized.data(), normalized.size());
+    }
+
+    inline std::uint64_t AlignUp(std::uint64_t value, std::uint64_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
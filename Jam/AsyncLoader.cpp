@@ -0,0 +1,159 @@
+#include "AsyncLoader.h"
+#include "ResourceCache.h"
+#include <algorithm>
+#include <iostream>
+
+AsyncLoader::AsyncLoader(unsigned workerCount)
+{
+    if (workerCount == 0) {
+        const unsigned hw = std::thread::hardware_concurrency();
+        workerCount = hw > 1 ? hw - 1 : 1;
+    }
+    // Decoding is disk and memory bound; more than a few workers only adds contention
+    workerCount = std::min(workerCount, 4u);
+
+    m_workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i)
+        m_workers.emplace_back(&AsyncLoader::workerLoop, this);
+}
+
+AsyncLoader::~AsyncLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_jobMutex);
+        m_stopping = true;
+        m_jobs.clear();
+    }
+    m_jobReady.notify_all();
+    for (auto& t : m_workers) t.join();
+}
+
+void AsyncLoader::QueueTexture(const std::string& path, bool smooth, bool repeated, bool keepImage)
+{
+    queue({ Kind::Texture, path, smooth, repeated, keepImage });
+}
+
+void AsyncLoader::QueueImage(const std::string& path, float scale)
+{
+    Job job{ Kind::Image, path };
+    job.scale = scale;
+    queue(std::move(job));
+}
+
+void AsyncLoader::QueueSound(const std::string& path)
+{
+    queue({ Kind::Sound, path });
+}
+
+void AsyncLoader::queue(Job job)
+{
+    ++m_total;
+    {
+        std::lock_guard<std::mutex> lock(m_jobMutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_jobReady.notify_one();
+}
+
+void AsyncLoader::workerLoop()
+{
+    for (;;) {
+        Decoded item;
+        {
+            std::unique_lock<std::mutex> lock(m_jobMutex);
+            m_jobReady.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping) return;
+            item.job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        decode(item);
+
+        std::lock_guard<std::mutex> lock(m_doneMutex);
+        m_decoded.push_back(std::move(item));
+    }
+}
+
+void AsyncLoader::decode(Decoded& out)
+{
+    // Worker thread: no GL or AL calls here, only file reads and decoding.
+    // The pack is mounted before loading starts and only read afterwards.
+    const PackBlob blob = ResourceCache::Shared().Pack().Find(out.job.path);
+
+    if (out.job.kind == Kind::Sound) {
+        PackStream stream(blob);
+        sf::InputSoundFile file;
+        if (!(blob ? file.openFromStream(stream) : file.openFromFile(out.job.path))) return;
+        out.channelCount = file.getChannelCount();
+        out.sampleRate = file.getSampleRate();
+        out.samples.resize(static_cast<std::size_t>(file.getSampleCount()));
+        const sf::Uint64 read = file.read(out.samples.data(), out.samples.size());
+        out.samples.resize(static_cast<std::size_t>(read));
+        out.ok = read > 0;
+        return;
+    }
+
+    if (out.job.kind == Kind::Texture && !out.job.keepImage) {
+        out.blob = DecodedTextureCache::Shared().Open(out.job.path, blob);
+        if (out.blob) {
+            out.ok = true;
+            return;
+        }
+    }
+
+    out.image = std::make_shared<sf::Image>();
+    out.ok = ResourceCache::Shared().DecodeImage(out.job.path, *out.image, out.job.scale);
+}
+
+void AsyncLoader::publish(Decoded& item)
+{
+    ResourceCache& cache = ResourceCache::Shared();
+    const Job& job = item.job;
+
+    if (!item.ok) {
+        std::cerr << "Warning: background load failed: " << job.path << "\n";
+        ++m_failed;
+        return;
+    }
+
+    if (job.kind == Kind::Sound) {
+        auto buffer = std::make_shared<sf::SoundBuffer>();
+        if (!buffer->loadFromSamples(item.samples.data(), item.samples.size(), item.channelCount, item.sampleRate)) {
+            std::cerr << "Warning: sound upload failed: " << job.path << "\n";
+            ++m_failed;
+            return;
+        }
+        cache.AddSoundBuffer(job.path, std::move(buffer));
+        return;
+    }
+
+    if (item.blob) {
+        if (!cache.AddTexture(job.path, job.smooth, job.repeated, *item.blob))
+            ++m_failed;
+        return;
+    }
+
+    cache.AddImage(job.path, std::move(item.image), job.scale);
+    if (job.kind == Kind::Texture && !cache.GetTexture(job.path, job.smooth, job.repeated))
+        ++m_failed;
+}
+
+bool AsyncLoader::Pump(sf::Time budget)
+{
+    sf::Clock clock;
+    while (!Done()) {
+        Decoded item;
+        {
+            std::lock_guard<std::mutex> lock(m_doneMutex);
+            if (m_decoded.empty()) break;
+            item = std::move(m_decoded.front());
+            m_decoded.pop_front();
+        }
+
+        publish(item);
+        ++m_completed;
+
+        if (clock.getElapsedTime() >= budget) break;
+    }
+    return Done();
+}
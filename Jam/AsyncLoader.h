@@ -0,0 +1,92 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+#include <SFML/System.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "DecodedTextureCache.h"
+
+// Loads assets into ResourceCache without stalling the main thread.
+// Worker threads decode files into sf::Image pixels and 16-bit samples;
+// Pump(), called once per frame on the main thread, publishes the decoded
+// data to the cache and does the GPU/OpenAL uploads until its time budget
+// is used up. Once everything is resident the usual ResourceCache getters
+// hit instead of touching the disk.
+class AsyncLoader {
+public:
+    // workerCount 0 picks hardware threads - 1 (at least one)
+    explicit AsyncLoader(unsigned workerCount = 0);
+    ~AsyncLoader();
+
+    AsyncLoader(const AsyncLoader&) = delete;
+    AsyncLoader& operator=(const AsyncLoader&) = delete;
+
+    // Decoded off-thread, uploaded as a texture by Pump. Unless keepImage is
+    // set, a valid DecodedTextureCache entry is mapped and uploaded directly
+    // and no sf::Image is made.
+    void QueueTexture(const std::string& path, bool smooth = false, bool repeated = false, bool keepImage = false);
+    // Decoded off-thread and kept as an image (e.g. frames packed into sheets
+    // later). `scale` < 1 bakes it down with TextureBaker on the worker too.
+    void QueueImage(const std::string& path, float scale = 1.f);
+    // Decoded off-thread, uploaded as a sound buffer by Pump
+    void QueueSound(const std::string& path);
+
+    // Main thread. Always finishes at least one ready item so progress is
+    // made even when a single upload exceeds the budget. Returns Done().
+    bool Pump(sf::Time budget);
+
+    std::size_t Total() const { return m_total; }
+    std::size_t Completed() const { return m_completed; }
+    std::size_t Failed() const { return m_failed; }
+    float Progress() const { return m_total ? static_cast<float>(m_completed) / static_cast<float>(m_total) : 1.f; }
+    bool Done() const { return m_completed == m_total; }
+
+private:
+    enum class Kind { Texture, Image, Sound };
+
+    struct Job {
+        Kind kind = Kind::Image;
+        std::string path;
+        bool smooth = false;
+        bool repeated = false;
+        bool keepImage = false;
+        float scale = 1.f;
+    };
+
+    struct Decoded {
+        Job job;
+        bool ok = false;
+        std::shared_ptr<sf::Image> image;
+        std::unique_ptr<DecodedBlob> blob;
+        std::vector<sf::Int16> samples;
+        unsigned channelCount = 0;
+        unsigned sampleRate = 0;
+    };
+
+    void queue(Job job);
+    void workerLoop();
+    static void decode(Decoded& out);
+    void publish(Decoded& item);
+
+private:
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_jobMutex;
+    std::condition_variable m_jobReady;
+    std::deque<Job> m_jobs;
+    bool m_stopping = false;
+
+    std::mutex m_doneMutex;
+    std::deque<Decoded> m_decoded;
+
+    // Main-thread counters
+    std::size_t m_total = 0;
+    std::size_t m_completed = 0;
+    std::size_t m_failed = 0;
+};
@@ -0,0 +1,155 @@
+#include "AudioBatch.h"
+#include "AudioEmitter.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define JAM_AUDIO_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+    constexpr float CURVE_K = 9.f; // shape of the inverse-square and log curves
+    constexpr float MIN_LENGTH = 1e-3f;
+
+    DistanceLut buildLut(DistanceModelEnum model)
+    {
+        DistanceLut lut;
+        const float invSquareEnd = 1.f / ((1.f + CURVE_K) * (1.f + CURVE_K));
+        for (int i = 0; i <= DistanceLut::SIZE; ++i) {
+            const float u = static_cast<float>(i) / DistanceLut::SIZE;
+            float g = 0.f;
+            switch (model) {
+            case DistanceModelEnum::Linear:
+                g = 1.f - u;
+                break;
+            case DistanceModelEnum::InverseSquare: {
+                const float r = 1.f / ((1.f + CURVE_K * u) * (1.f + CURVE_K * u));
+                g = (r - invSquareEnd) / (1.f - invSquareEnd);
+                break;
+            }
+            case DistanceModelEnum::Logarithmic:
+                g = 1.f - std::log(1.f + CURVE_K * u) / std::log(1.f + CURVE_K);
+                break;
+            }
+            lut.values[i] = std::clamp(g, 0.f, 1.f);
+        }
+        lut.values[DistanceLut::SIZE + 1] = lut.values[DistanceLut::SIZE];
+        return lut;
+    }
+
+    float lookup(const DistanceLut& curve, float u)
+    {
+        const float f = u * DistanceLut::SIZE;
+        const int i = static_cast<int>(f);
+        const float a = curve.values[i];
+        return a + (curve.values[i + 1] - a) * (f - static_cast<float>(i));
+    }
+}
+
+const DistanceLut& DistanceLut::For(DistanceModelEnum model)
+{
+    static const DistanceLut luts[] = {
+        buildLut(DistanceModelEnum::Linear),
+        buildLut(DistanceModelEnum::InverseSquare),
+        buildLut(DistanceModelEnum::Logarithmic),
+    };
+    return luts[static_cast<std::size_t>(model)];
+}
+
+void EmitterBatch::Clear()
+{
+    emitters.clear();
+    x.clear();
+    y.clear();
+    minDistance.clear();
+    invRange.clear();
+    volume.clear();
+    alpha.clear();
+    gain.clear();
+    finalVolume.clear();
+    pan.clear();
+}
+
+void EmitterBatch::Push(AudioEmitter& e, float laneVolume, float laneAlpha)
+{
+    emitters.push_back(&e);
+    x.push_back(e.mixPosition.x);
+    y.push_back(e.mixPosition.y);
+    const float minD = std::max(MIN_LENGTH, e.minDistance);
+    minDistance.push_back(minD);
+    invRange.push_back(1.f / std::max(1e-4f, e.maxDistance - minD));
+    volume.push_back(laneVolume);
+    alpha.push_back(laneAlpha);
+    gain.push_back(e.currentGain);
+    finalVolume.push_back(0.f);
+    pan.push_back(0.f);
+}
+
+static void evaluateScalar(EmitterBatch& b, std::size_t begin, std::size_t end, float lx, float ly,
+    const DistanceLut& curve, float panStrength)
+{
+    for (std::size_t i = begin; i < end; ++i) {
+        const float dx = b.x[i] - lx;
+        const float dy = b.y[i] - ly;
+        const float distance = std::sqrt(dx * dx + dy * dy);
+        const float u = std::clamp((distance - b.minDistance[i]) * b.invRange[i], 0.f, 1.f);
+        const float target = lookup(curve, u);
+        b.gain[i] += (target - b.gain[i]) * b.alpha[i];
+        b.finalVolume[i] = std::clamp(b.volume[i] * b.gain[i], 0.f, 1.f);
+
+        const float nearField = std::min(1.f, distance / b.minDistance[i]);
+        b.pan[i] = std::clamp(dx / std::max(distance, MIN_LENGTH) * panStrength * nearField, -1.f, 1.f);
+    }
+}
+
+void EvaluateGains(EmitterBatch& b, float lx, float ly, const DistanceLut& curve, float panStrength)
+{
+    const std::size_t n = b.Size();
+    std::size_t i = 0;
+
+#ifdef JAM_AUDIO_SSE
+    const __m128 listenerX = _mm_set1_ps(lx);
+    const __m128 listenerY = _mm_set1_ps(ly);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 minusOne = _mm_set1_ps(-1.f);
+    const __m128 lutScale = _mm_set1_ps(static_cast<float>(DistanceLut::SIZE));
+    const __m128 minLength = _mm_set1_ps(MIN_LENGTH);
+    const __m128 strength = _mm_set1_ps(panStrength);
+    alignas(16) int index[4];
+
+    for (; i + 4 <= n; i += 4) {
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(&b.x[i]), listenerX);
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(&b.y[i]), listenerY);
+        const __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        const __m128 minDistance = _mm_loadu_ps(&b.minDistance[i]);
+
+        // Curve lookup: indices in SIMD, four scalar loads, interpolation in SIMD
+        __m128 u = _mm_mul_ps(_mm_sub_ps(distance, minDistance), _mm_loadu_ps(&b.invRange[i]));
+        u = _mm_min_ps(_mm_max_ps(u, zero), one);
+        const __m128 f = _mm_mul_ps(u, lutScale);
+        const __m128i fi = _mm_cvttps_epi32(f);
+        const __m128 frac = _mm_sub_ps(f, _mm_cvtepi32_ps(fi));
+        _mm_store_si128(reinterpret_cast<__m128i*>(index), fi);
+        const float* v = curve.values.data();
+        const __m128 a = _mm_setr_ps(v[index[0]], v[index[1]], v[index[2]], v[index[3]]);
+        const __m128 c = _mm_setr_ps(v[index[0] + 1], v[index[1] + 1], v[index[2] + 1], v[index[3] + 1]);
+        const __m128 target = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(c, a), frac));
+
+        __m128 gain = _mm_loadu_ps(&b.gain[i]);
+        gain = _mm_add_ps(gain, _mm_mul_ps(_mm_sub_ps(target, gain), _mm_loadu_ps(&b.alpha[i])));
+        _mm_storeu_ps(&b.gain[i], gain);
+
+        const __m128 volume = _mm_mul_ps(_mm_loadu_ps(&b.volume[i]), gain);
+        _mm_storeu_ps(&b.finalVolume[i], _mm_min_ps(_mm_max_ps(volume, zero), one));
+
+        const __m128 nearField = _mm_min_ps(one, _mm_div_ps(distance, minDistance));
+        __m128 pan = _mm_div_ps(dx, _mm_max_ps(distance, minLength));
+        pan = _mm_mul_ps(_mm_mul_ps(pan, strength), nearField);
+        _mm_storeu_ps(&b.pan[i], _mm_min_ps(_mm_max_ps(pan, minusOne), one));
+    }
+#endif
+
+    evaluateScalar(b, i, n, lx, ly, curve, panStrength);
+}
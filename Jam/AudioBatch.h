@@ -0,0 +1,48 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <vector>
+
+struct AudioEmitter;
+
+enum class DistanceModelEnum { Linear, InverseSquare, Logarithmic };
+
+// Attenuation sampled over the normalised distance
+// u = (distance - minDistance) / (maxDistance - minDistance), so every
+// model costs the same interpolated table lookup. All curves are 1 at
+// u = 0 and reach 0 at u = 1:
+//   Linear         1 - u
+//   InverseSquare  1 / (1 + 9u)^2, rescaled (max distance = 10x reference)
+//   Logarithmic    1 - ln(1 + 9u) / ln(10)
+struct DistanceLut {
+    static constexpr int SIZE = 256;
+    std::array<float, SIZE + 2> values{}; // SIZE + 1 samples, plus one so u = 1 can read i + 1
+
+    static const DistanceLut& For(DistanceModelEnum model);
+};
+
+// Structure-of-arrays copy of the emitters that are playing this frame.
+// AudioManager::Update rebuilds it (stopped emitters are culled before
+// any maths) and EvaluateGains runs over it in one vectorised pass.
+struct EmitterBatch {
+    std::vector<AudioEmitter*> emitters;
+    std::vector<float> x, y;            // meters
+    std::vector<float> minDistance;
+    std::vector<float> invRange;        // 1 / (maxDistance - minDistance)
+    std::vector<float> volume;          // base * category * master
+    std::vector<float> alpha;           // smoothing step; 1 snaps to the target
+    std::vector<float> gain;            // in: last smoothed gain, out: this frame's
+    std::vector<float> finalVolume;     // out, 0..1
+    std::vector<float> pan;             // out, -1 (left) .. 1 (right)
+
+    std::size_t Size() const { return emitters.size(); }
+    void Clear();
+    void Push(AudioEmitter& e, float volume, float alpha);
+};
+
+// Distance attenuation through `curve`, exponential smoothing, final
+// volume and left/right pan for every lane. Pan follows the direction
+// to the emitter, scaled by panStrength and eased to centre inside
+// minDistance. Uses SSE where available.
+void EvaluateGains(EmitterBatch& batch, float listenerX, float listenerY,
+    const DistanceLut& curve, float panStrength);
@@ -0,0 +1,234 @@
+#include "AudioBenchmark.h"
+#include "SoftwareMixer.h"
+#include <SFML/Audio.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr std::array<unsigned, 3> VOICE_COUNTS = { 8, 64, 512 };
+    constexpr int MIX_BLOCKS = 200;       // blocks rendered per software measurement
+    constexpr int UPDATE_TICKS = 100;     // volume/pan passes per update measurement
+    constexpr int LATENCY_TRIALS = 20;
+    constexpr float LATENCY_TIMEOUT = 1.f; // seconds
+    // OpenAL Soft hands out 256 sources by default; leave a few for the probe
+    constexpr unsigned MAX_SOURCES = 250;
+
+    struct Result {
+        const char* path;
+        unsigned voices;
+        unsigned playing = 0;          // voices that actually got to play
+        float triggerMicros = 0.f;     // caller's cost per trigger
+        float updateMicros = 0.f;      // caller's cost to re-gain every voice once
+        float mixMicros = -1.f;        // per block; -1 where OpenAL mixes out of sight
+        float latencyMeanMs = -1.f;    // trigger until mixed; -1 if it never was
+        float latencyMaxMs = -1.f;
+    };
+
+    // One second of noise: every voice reads a different part of the cache
+    std::shared_ptr<sf::SoundBuffer> makeNoise()
+    {
+        std::vector<sf::Int16> samples(SoftwareMixer::SAMPLE_RATE);
+        std::uint32_t seed = 0x2545F491u;
+        for (sf::Int16& s : samples) {
+            seed = seed * 1664525u + 1013904223u;
+            s = static_cast<sf::Int16>((static_cast<int>(seed >> 16) - 32768) / 8);
+        }
+        auto buffer = std::make_shared<sf::SoundBuffer>();
+        if (!buffer->loadFromSamples(samples.data(), samples.size(), 1, SoftwareMixer::SAMPLE_RATE)) return nullptr;
+        return buffer;
+    }
+
+    // A single frame: finished as soon as it has been mixed once
+    std::shared_ptr<sf::SoundBuffer> makeClick()
+    {
+        const sf::Int16 sample = 8000;
+        auto buffer = std::make_shared<sf::SoundBuffer>();
+        if (!buffer->loadFromSamples(&sample, 1, 1, SoftwareMixer::SAMPLE_RATE)) return nullptr;
+        return buffer;
+    }
+
+    float pan(unsigned i, unsigned count) { return count > 1 ? -1.f + 2.f * i / (count - 1) : 0.f; }
+    // Every fourth voice is pitched, so the resampling kernel is in the mix too
+    float pitch(unsigned i) { return i % 4 == 3 ? 1.06f : 1.f; }
+
+    // Waits for `finished` after a trigger at `start`; seconds, or -1 on timeout
+    template <typename Finished>
+    float waitMixed(const sf::Clock& start, Finished finished)
+    {
+        while (!finished()) {
+            if (start.getElapsedTime().asSeconds() > LATENCY_TIMEOUT) return -1.f;
+            std::this_thread::yield();
+        }
+        return start.getElapsedTime().asSeconds();
+    }
+
+    template <typename Trial>
+    void measureLatency(Result& r, Trial trial)
+    {
+        float total = 0.f;
+        int count = 0;
+        for (int i = 0; i < LATENCY_TRIALS; ++i) {
+            const float seconds = trial();
+            if (seconds < 0.f) continue;
+            total += seconds;
+            r.latencyMaxMs = std::max(r.latencyMaxMs, seconds * 1000.f);
+            ++count;
+            // Land the next trigger at a different point of the refill cycle
+            sf::sleep(sf::milliseconds(3 + i % 7));
+        }
+        if (count > 0) r.latencyMeanMs = total / count * 1000.f;
+    }
+
+    Result benchSoftware(unsigned voices, const std::shared_ptr<sf::SoundBuffer>& noise,
+        const std::shared_ptr<sf::SoundBuffer>& click)
+    {
+        Result r{ "software", voices };
+        // The last voice is kept free for the latency trigger
+        SoftwareMixer mixer(voices + 1);
+        std::vector<sf::Int16> out(SoftwareMixer::BLOCK_FRAMES * 2);
+
+        sf::Clock clock;
+        for (unsigned i = 0; i < voices; ++i)
+            mixer.Start(static_cast<int>(i), AudioCategory::Effects, noise, true, sf::seconds(static_cast<float>(i % 97) / 97.f),
+                0.5f, pan(i, voices), pitch(i), false);
+        r.triggerMicros = static_cast<float>(clock.getElapsedTime().asMicroseconds()) / voices;
+        r.playing = voices;
+
+        mixer.RenderBlock(out.data()); // applies the starts
+        clock.restart();
+        for (int b = 0; b < MIX_BLOCKS; ++b) mixer.RenderBlock(out.data());
+        r.mixMicros = static_cast<float>(clock.getElapsedTime().asMicroseconds()) / MIX_BLOCKS;
+
+        // The audio thread's share: one gain command per voice that moved
+        clock.restart();
+        for (int t = 0; t < UPDATE_TICKS; ++t) {
+            for (unsigned i = 0; i < voices; ++i)
+                mixer.SetGain(static_cast<int>(i), 0.5f, pan((i + t) % voices, voices));
+            mixer.RenderBlock(out.data()); // drains the queue, not timed separately
+        }
+        const float updateAndMix = static_cast<float>(clock.getElapsedTime().asMicroseconds()) / UPDATE_TICKS;
+        r.updateMicros = std::max(0.f, updateAndMix - r.mixMicros);
+
+        // Live: trigger a one-frame voice over the full load and wait until
+        // the stream thread has mixed it
+        mixer.play();
+        sf::sleep(sf::milliseconds(100));
+        const int probe = static_cast<int>(voices);
+        measureLatency(r, [&] {
+            sf::Clock start;
+            mixer.Start(probe, AudioCategory::Effects, click, false, sf::Time::Zero, 0.5f, 0.f, 1.f, false);
+            return waitMixed(start, [&] { return mixer.IsFinished(probe); });
+        });
+        mixer.stop();
+        return r;
+    }
+
+    Result benchSources(unsigned voices, const std::shared_ptr<sf::SoundBuffer>& noise,
+        const std::shared_ptr<sf::SoundBuffer>& click)
+    {
+        Result r{ "sf::Sound", voices };
+        // Set up the way VoicePool sets up its voices. Past the source limit
+        // every sf::Sound fails to get a source, so don't ask for them.
+        const unsigned count = std::min(voices, MAX_SOURCES);
+        std::vector<std::unique_ptr<sf::Sound>> sounds;
+        sounds.reserve(count);
+        for (unsigned i = 0; i < count; ++i) {
+            auto sound = std::make_unique<sf::Sound>(*noise);
+            sound->setRelativeToListener(true);
+            sound->setAttenuation(0.f);
+            sound->setLoop(true);
+            sound->setVolume(50.f);
+            sound->setPitch(pitch(i));
+            sound->setPosition(pan(i, voices), 0.f, -1.f);
+            sounds.push_back(std::move(sound));
+        }
+
+        sf::Clock clock;
+        for (auto& sound : sounds) sound->play();
+        r.triggerMicros = static_cast<float>(clock.getElapsedTime().asMicroseconds()) / count;
+        // A device may have fewer sources still; sounds past it stay stopped
+        for (auto& sound : sounds)
+            if (sound->getStatus() == sf::Sound::Playing) ++r.playing;
+
+        clock.restart();
+        for (int t = 0; t < UPDATE_TICKS; ++t) {
+            for (unsigned i = 0; i < count; ++i) {
+                sounds[i]->setVolume(50.f - static_cast<float>(t % 2));
+                sounds[i]->setPosition(pan((i + t) % voices, voices), 0.f, -1.f);
+            }
+        }
+        // Scaled up to every requested voice, so rows compare per voice count
+        r.updateMicros = static_cast<float>(clock.getElapsedTime().asMicroseconds()) / UPDATE_TICKS * voices / count;
+
+        sf::Sound probe(*click);
+        probe.setRelativeToListener(true);
+        sf::sleep(sf::milliseconds(100));
+        measureLatency(r, [&] {
+            sf::Clock start;
+            probe.play();
+            return waitMixed(start, [&] { return probe.getStatus() == sf::Sound::Stopped; });
+        });
+
+        for (auto& sound : sounds) sound->stop();
+        return r;
+    }
+}
+
+namespace AudioBenchmark {
+
+bool Run(const std::string& csvPath)
+{
+    const std::shared_ptr<sf::SoundBuffer> noise = makeNoise();
+    const std::shared_ptr<sf::SoundBuffer> click = makeClick();
+    if (!noise || !click) {
+        std::cerr << "Warning: audio benchmark could not create its buffers" << std::endl;
+        return false;
+    }
+
+    // Everything still plays and mixes, just silently
+    const float volume = sf::Listener::getGlobalVolume();
+    sf::Listener::setGlobalVolume(0.f);
+    std::vector<Result> results;
+    for (unsigned voices : VOICE_COUNTS) {
+        results.push_back(benchSources(voices, noise, click));
+        results.push_back(benchSoftware(voices, noise, click));
+    }
+    sf::Listener::setGlobalVolume(volume);
+
+    const float blockMicros = 1e6f * SoftwareMixer::BLOCK_FRAMES / SoftwareMixer::SAMPLE_RATE;
+    std::cout << "Audio benchmark (trigger latency = until mixed; the software path adds "
+        << std::fixed << std::setprecision(1) << 3.f * blockMicros / 1000.f << " ms of queued blocks, OpenAL its device buffer)\n"
+        << "path       voices playing trigger_us update_us  mix_us/block  cpu%   latency_ms(mean/max)\n";
+    for (const Result& r : results) {
+        std::cout << std::left << std::setw(11) << r.path << std::right
+            << std::setw(6) << r.voices << std::setw(8) << r.playing
+            << std::setprecision(2) << std::setw(11) << r.triggerMicros
+            << std::setw(10) << r.updateMicros;
+        if (r.mixMicros >= 0.f)
+            std::cout << std::setw(14) << r.mixMicros << std::setw(7) << 100.f * r.mixMicros / blockMicros;
+        else
+            std::cout << std::setw(14) << "(OpenAL)" << std::setw(7) << "-";
+        std::cout << std::setw(10) << r.latencyMeanMs << " / " << r.latencyMaxMs << "\n";
+    }
+    std::cout << std::flush;
+
+    std::ofstream csv(csvPath);
+    if (!csv) {
+        std::cerr << "Warning: could not write audio benchmark to " << csvPath << std::endl;
+        return false;
+    }
+    csv << "path,voices,playing,trigger_us,update_us,mix_us_per_block,latency_ms_mean,latency_ms_max\n";
+    for (const Result& r : results)
+        csv << r.path << ',' << r.voices << ',' << r.playing << ',' << r.triggerMicros << ',' << r.updateMicros << ','
+            << r.mixMicros << ',' << r.latencyMeanMs << ',' << r.latencyMaxMs << '\n';
+    return true;
+}
+
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+
+// Benchmark (--audio-benchmark): SoftwareMixer against one sf::Sound per
+// voice at 8, 64 and 512 concurrent voices. For each path it measures what
+// a trigger costs the caller, the per-tick cost of pushing volume and pan
+// to every voice, the mixing cost where it is ours to see, and trigger
+// latency (trigger until the voice has been mixed). The sf::Sound path is
+// capped at what OpenAL can give it. Output is muted throughout. Blocks
+// for a few seconds, so run it before the game starts its audio; prints a
+// table and writes the rows to `csvPath`.
+namespace AudioBenchmark {
+    bool Run(const std::string& csvPath);
+}
@@ -0,0 +1,87 @@
+#include "AudioEmitter.h"
+#include "VoicePool.h"
+#include <algorithm>
+
+
+void AudioEmitter::startInstance() {
+	if (!buffer) return;
+
+	// Over the limit the oldest instance makes room, which for maxInstances == 1
+	// is the old restart behaviour (used by the ambient loops)
+	while (!instances.empty() && instances.size() >= std::max(1u, maxInstances)) {
+		if (pool) pool->Release(instances.front());
+		instances.erase(instances.begin());
+	}
+
+	instances.emplace_back();
+	if (pool && !busPaused) pool->TryBind(*this, instances.back());
+}
+
+
+void AudioEmitter::stopInstances() {
+	if (pool) {
+		for (EmitterInstance& inst : instances) pool->Release(inst);
+	}
+	instances.clear();
+}
+
+
+void AudioEmitter::pauseInstances() {
+	for (EmitterInstance& inst : instances) {
+		if (inst.paused) continue;
+		inst.paused = true;
+		if (pool && inst.voice >= 0) pool->PauseVoice(inst.voice);
+	}
+}
+
+
+void AudioEmitter::resumeInstances() {
+	for (EmitterInstance& inst : instances) {
+		if (!inst.paused) continue;
+		inst.paused = false;
+		if (pool && inst.voice >= 0 && !busPaused) pool->ResumeVoice(inst.voice);
+	}
+}
+
+
+sf::SoundSource::Status AudioEmitter::mixStatus() const {
+	if (instances.empty()) return sf::SoundSource::Stopped;
+	for (const EmitterInstance& inst : instances)
+		if (!inst.paused) return sf::SoundSource::Playing;
+	return sf::SoundSource::Paused;
+}
+
+
+void AudioEmitter::advance(float dt) {
+	if (!buffer) {
+		stopInstances();
+		return;
+	}
+	const sf::Int64 length = buffer->getDuration().asMicroseconds();
+
+	for (auto it = instances.begin(); it != instances.end(); ) {
+		EmitterInstance& inst = *it;
+		if (inst.paused) { ++it; continue; }
+
+		inst.position += sf::seconds(dt * pitch);
+		bool finished;
+		if (loop) {
+			finished = false;
+			if (length > 0) inst.position = sf::microseconds(inst.position.asMicroseconds() % length);
+		}
+		else if (pool && inst.voice >= 0) {
+			finished = pool->IsFinished(inst.voice); // the voice knows exactly
+		}
+		else {
+			finished = inst.position.asMicroseconds() >= length;
+		}
+
+		if (finished) {
+			if (pool) pool->Release(inst);
+			it = instances.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
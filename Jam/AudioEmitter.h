@@ -4,59 +4,115 @@
 
 #include <SFML/Audio.hpp>
 #include <box2d/box2d.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 #include <iostream>
+#include "SoundBank.h"
 
 
 // Enums shared by emitters and manager
 enum class AudioCategory { Music, Background, Dialogue, Effects };
+inline constexpr std::size_t AUDIO_CATEGORY_COUNT = 4;
 
+// Mixer buses: Master feeds one bus per category
+enum class AudioBus { Master, Music, Background, Dialogue, Effects };
+inline constexpr std::size_t AUDIO_BUS_COUNT = 5;
+inline AudioBus BusFor(AudioCategory category) { return static_cast<AudioBus>(static_cast<int>(category) + 1); }
 
+class VoicePool;
+
+
+// One play() of an emitter. Its playback position is tracked even while
+// it has no voice, so a sound that drifts out of range and back resumes
+// where it would have been.
+struct EmitterInstance {
+	int voice = -1;          // VoicePool slot while audible, -1 while virtual
+	sf::Time position;       // playback position
+	bool paused = false;
+};
+
+
+// A positioned sound source. Emitters own no OpenAL source: each play()
+// starts an instance that borrows a voice from the AudioManager's
+// VoicePool only while it is audible, so re-triggering overlaps instead
+// of cutting the previous instance off.
+//
+// Game code sets up the fields, hands the emitter to
+// AudioManager::AddEmitter and from then on drives it through the
+// returned EmitterHandle. Everything under "mix state" belongs to the
+// audio thread.
 struct AudioEmitter {
-	std::string id;
+	std::string id; // for debugging only
 	AudioCategory category = AudioCategory::Effects;
-	b2Vec2 position = { 0.f, 0.f }; // Box2D meters
+	b2Vec2 position = { 0.f, 0.f }; // Box2D meters; initial, then AudioManager::SetPosition or an attachment
 	float minDistance = 0.5f; // meters
 	float maxDistance = 10.f; // meters
 	float baseVolume = 1.f; // 0..1
+	int priority = 0; // higher keeps its voices when the pool runs out
+	unsigned maxInstances = 4; // overlapping plays; the oldest is cut beyond this
+	bool loop = false;
+	float pitch = 1.f; // playback speed; 1 = as recorded
+	std::string sound; // SoundBank path; the manager makes it resident as the emitter comes in range
+	// Decoded PCM. For a bank sound the manager sets it (audio thread once
+	// added); set it directly for a buffer made some other way.
+	std::shared_ptr<const sf::SoundBuffer> buffer;
+
+	// Mix state (audio thread)
+	b2Vec2 mixPosition = { 0.f, 0.f }; // last position the audio thread received
 	float currentGain = 0.f; // 0..1
-	sf::Sound sound;
-	std::shared_ptr<sf::SoundBuffer> buffer;
+	float finalVolume = 0.f; // 0..1, what the voices were last given
+	float pan = 0.f; // -1 (left) .. 1 (right), relative to the listener
+	std::vector<EmitterInstance> instances;
+	VoicePool* pool = nullptr; // set while registered with an AudioManager
+	bool active = false; // had instances at the last mix tick
+	bool busPaused = false; // its bus (or Master) is paused: clocks stop, voices hold
+
+	// Status handoff. The audio thread publishes the mix status after each
+	// command it applies and after every tick; until it has applied all the
+	// commands posted so far, AudioManager::GetStatus answers with what
+	// they lead to.
+	std::atomic<int> publishedStatus{ sf::SoundSource::Stopped };
+	std::atomic<std::uint32_t> commandsApplied{ 0 }; // audio thread
+	std::uint32_t commandsPosted = 0; // game thread
+	sf::SoundSource::Status expectedStatus = sf::SoundSource::Stopped; // game thread
 
 
 	AudioEmitter() = default;
 
+	AudioEmitter(const AudioEmitter&) = delete;
+	AudioEmitter& operator=(const AudioEmitter&) = delete;
+
 
 	bool loadBuffer(const std::string& path) {
-		buffer = std::make_shared<sf::SoundBuffer>();
-		if (!buffer->loadFromFile(path)) {
+		// Only registers the file: emitters playing the same sound share one
+		// bank entry, decoded when one of them comes within range
+		if (!SoundBank::Shared().Add(path)) {
 			std::cerr << "Failed to load sound buffer: " << path << std::endl;
-			buffer.reset();
 			return false;
 		}
-		sound.setBuffer(*buffer);
+		sound = path;
 		return true;
 	}
 
-
-	void play() {
-		if (!buffer) return;
-		// Ensure the sound restarts when requested (stop current play first)
-		if (sound.getStatus() == sf::Sound::Playing) {
-			sound.stop();
-			// reset to beginning
-			sound.setPlayingOffset(sf::Time::Zero);
-		}
-		sound.play();
-	}
-	void stop() { sound.stop(); }
-
-
-	void applyVolume(float finalVolume) {
-		float v = std::clamp(finalVolume * 100.f, 0.f, 100.f);
-		sound.setVolume(v);
-	}
+	void setLoop(bool looping) { loop = looping; }
+
+	// Audio thread: what AudioManager's Play/Stop/Pause/Resume do once the
+	// commands arrive.
+	// Start a new instance from the beginning
+	void startInstance();
+	// Stop every instance and return their voices
+	void stopInstances();
+	void pauseInstances();
+	void resumeInstances();
+	// Playing if any instance is running, Paused if all are paused
+	sf::SoundSource::Status mixStatus() const;
+
+	// Advance instance clocks by dt and drop instances that finished
+	void advance(float dt);
 };
 
 
@@ -1,15 +1,13 @@
 #include "AudioManager.h"
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 
 AudioManager::AudioManager() {
     settings.distanceModel = DistanceModelEnum::Linear;
     settings.smoothingTime = 0.08f;
 
-    masterVolume = 1.f;
-    musicVolume = 1.f;
-    backgroundVolume = 1.f;
-    dialogueVolume = 1.f;
-    effectsVolume = 1.f;
+    m_busVolume.fill(1.f);
 
     crossfadeTime = 1.0f;
     crossfadeTimer = 0.f;
@@ -18,125 +16,634 @@ AudioManager::AudioManager() {
     m_targetTrack = MusicTrack::Neutral;
 }
 
+AudioManager::~AudioManager() {
+    StopThread();
+
+    // Game code may keep its emitter handles longer than the manager lives
+    for (EmitterSlot& slot : m_slots) {
+        if (!slot.emitter) continue;
+        slot.emitter->stopInstances();
+        slot.emitter->pool = nullptr;
+    }
+}
+
+void AudioManager::StartThread() {
+    if (Threaded()) return;
+    m_threadRunning.store(true, std::memory_order_release);
+    m_thread = std::thread(&AudioManager::threadMain, this);
+}
+
+void AudioManager::StopThread() {
+    if (!Threaded()) return;
+    m_threadRunning.store(false, std::memory_order_release);
+    m_thread.join();
+    // Anything posted after the last tick still happens, just on this thread
+    drainCommands();
+}
+
+bool AudioManager::EnableSoftwareMixer(unsigned voices) {
+    if (Threaded() || m_voices.ActiveVoices() > 0) {
+        std::cerr << "Warning: software mixing can only be enabled before the audio thread starts and while nothing plays" << std::endl;
+        return false;
+    }
+    if (m_mixer && m_mixer->VoiceCount() == voices) return true;
+
+    m_voices.UseMixer(nullptr);
+    m_mixer = std::make_unique<SoftwareMixer>(voices);
+    m_voices.UseMixer(m_mixer.get());
+    // Always running; it mixes silence while no voice plays
+    m_mixer->play();
+    return true;
+}
+
+void AudioManager::threadMain() {
+    // sf::sleep raises the Windows timer resolution, so 10 ms ticks stay 10 ms
+    const sf::Time step = sf::seconds(1.f / TICK_RATE);
+    sf::Clock clock;
+    sf::Time last = clock.getElapsedTime();
+    sf::Time next = last;
+
+    while (m_threadRunning.load(std::memory_order_acquire)) {
+        drainCommands();
+
+        // Real elapsed time, so late wake-ups don't slow fades or clocks down
+        const sf::Time now = clock.getElapsedTime();
+        tick(std::min((now - last).asSeconds(), 0.1f));
+        last = now;
+
+        next += step;
+        const sf::Time after = clock.getElapsedTime();
+        if (next > after) sf::sleep(next - after);
+        else if (after - next > step * 4.f) next = after; // after a stall, don't burst to catch up
+    }
+}
+
+void AudioManager::drainCommands() {
+    Command c;
+    while (m_commands.TryPop(c)) {
+        apply(c);
+        m_commandsApplied.fetch_add(1, std::memory_order_release);
+    }
+}
+
+void AudioManager::post(const Command& c) {
+    ++m_commandsPosted;
+    if (!Threaded()) {
+        apply(c);
+        m_commandsApplied.fetch_add(1, std::memory_order_release);
+        return;
+    }
+    // A full queue means the audio thread is stalled; wait rather than drop
+    while (!m_commands.TryPush(c)) std::this_thread::yield();
+}
+
+void AudioManager::postEmitter(Command::Type type, AudioEmitter& e, sf::SoundSource::Status expected) {
+    e.expectedStatus = expected;
+    ++e.commandsPosted;
+    Command c;
+    c.type = type;
+    c.emitter = &e;
+    post(c);
+}
+
+void AudioManager::postBus(Command::Type type, AudioBus bus, float x, float y) {
+    Command c;
+    c.type = type;
+    c.index = static_cast<int>(bus);
+    c.x = x;
+    c.y = y;
+    post(c);
+}
+
+void AudioManager::apply(const Command& c) {
+    AudioEmitter* e = c.emitter;
+    switch (c.type) {
+    case Command::Type::AddEmitter:
+        e->pool = &m_voices;
+        e->mixPosition = { c.x, c.y };
+        e->active = false;
+        e->busPaused = busPaused(BusFor(e->category));
+        m_mixEmitters.push_back(e);
+        break;
+    case Command::Type::RemoveEmitter:
+        e->stopInstances();
+        e->pool = nullptr;
+        m_mixEmitters.erase(std::remove(m_mixEmitters.begin(), m_mixEmitters.end(), e), m_mixEmitters.end());
+        break;
+    case Command::Type::Play: e->startInstance(); break;
+    case Command::Type::Stop: e->stopInstances(); break;
+    case Command::Type::Pause: e->pauseInstances(); break;
+    case Command::Type::Resume: e->resumeInstances(); break;
+    case Command::Type::Position: e->mixPosition = { c.x, c.y }; break;
+    case Command::Type::Buffer:
+        // Only swapped on a stopped emitter, so no voice still plays the old one
+        if (e->buffer == c.buffer) break;
+        e->stopInstances();
+        e->buffer = c.buffer;
+        break;
+    case Command::Type::Listener: m_listener = { c.x, c.y }; break;
+    case Command::Type::BusVolume: m_buses[static_cast<std::size_t>(c.index)].volume = c.x; break;
+    case Command::Type::BusPause:
+    case Command::Type::BusResume:
+        m_buses[static_cast<std::size_t>(c.index)].paused = (c.type == Command::Type::BusPause);
+        applyBusPause();
+        break;
+    case Command::Type::BusMute: m_buses[static_cast<std::size_t>(c.index)].muted = (c.x != 0.f); break;
+    case Command::Type::BusFade: {
+        Bus& bus = m_buses[static_cast<std::size_t>(c.index)];
+        bus.fadeTarget = c.x;
+        if (c.y <= 0.f) {
+            bus.fade = c.x;
+            bus.fadeRate = 0.f;
+        }
+        else {
+            bus.fadeRate = std::abs(c.x - bus.fade) / c.y;
+        }
+        break;
+    }
+    case Command::Type::BusLowPass:
+    case Command::Type::BusReverb: applyInsert(c); break;
+    case Command::Type::CrossfadeTime: crossfadeTime = c.x; break;
+    case Command::Type::StartMusic:
+        // Start on the current track (neutral by default); the other stem runs silently alongside
+        if (m_music.getStatus() == sf::Music::Stopped && !m_musicHeld) {
+            for (MusicTrack t : { MusicTrack::Neutral, MusicTrack::Crazy })
+                m_music.SetStemGain(stemFor(t), t == m_currentTrack ? 1.f : 0.f, true);
+            applyMusicVolumes();
+            playMusic();
+        }
+        break;
+    case Command::Type::StopMusic:
+        m_music.stop();
+        m_musicHeld = false;
+        isCrossfading = false;
+        crossfadeTimer = 0.f;
+        m_targetTrack = m_currentTrack;
+        break;
+    case Command::Type::Crossfade: {
+        const MusicTrack target = static_cast<MusicTrack>(c.index);
+        if (isCrossfading && m_targetTrack == target) break;
+        if (!isCrossfading && m_currentTrack == target) break;
+        StartCrossfade(target);
+        break;
+    }
+    }
+
+    // Emitter commands hand their result back to GetStatus()
+    if (e && c.type != Command::Type::Position && c.type != Command::Type::Buffer) {
+        e->publishedStatus.store(e->mixStatus(), std::memory_order_relaxed);
+        if (c.type != Command::Type::AddEmitter && c.type != Command::Type::RemoveEmitter)
+            e->commandsApplied.fetch_add(1, std::memory_order_release);
+    }
+}
+
 bool AudioManager::loadMusic(const std::string& neutralPath, const std::string& crazyPath) {
-    if (!neutralMusic.openFromFile(neutralPath)) {
-        std::cerr << "Failed to open neutral music: " << neutralPath << std::endl;
+    if (Threaded()) {
+        std::cerr << "Warning: loadMusic called while the audio thread is running; ignored" << std::endl;
         return false;
     }
-    if (!crazyMusic.openFromFile(crazyPath)) {
-        std::cerr << "Failed to open crazy music: " << crazyPath << std::endl;
+    if (!m_music.Open({ neutralPath, crazyPath })) {
+        std::cerr << "Failed to open music: " << neutralPath << ", " << crazyPath << std::endl;
         return false;
     }
 
-    neutralMusic.setLoop(true);
-    crazyMusic.setLoop(true);
-
     // Initialize volumes, but DO NOT start playback here
-    neutralMusic.setVolume(masterVolume * musicVolume * 100.f);
-    crazyMusic.setVolume(0.f);
+    m_music.SetStemGain(stemFor(MusicTrack::Neutral), 1.f, true);
+    m_music.SetStemGain(stemFor(MusicTrack::Crazy), 0.f, true);
+    applyMusicVolumes();
     return true;
 }
 
-void AudioManager::StartMusic() {
-    // Start the current track (neutral by default)
-    sf::Music* cur = musicForTrack(m_currentTrack);
-    if (cur->getStatus() != sf::Music::Playing) {
-        cur->play();
-        applyMusicVolumes();
+void AudioManager::StartMusic() { Command c; c.type = Command::Type::StartMusic; post(c); }
+void AudioManager::StopMusic() { Command c; c.type = Command::Type::StopMusic; post(c); }
+
+void AudioManager::PauseBus(AudioBus bus) { postBus(Command::Type::BusPause, bus); }
+void AudioManager::ResumeBus(AudioBus bus) { postBus(Command::Type::BusResume, bus); }
+void AudioManager::SetBusMuted(AudioBus bus, bool muted) { postBus(Command::Type::BusMute, bus, muted ? 1.f : 0.f); }
+
+void AudioManager::FadeBus(AudioBus bus, float target, float seconds) {
+    postBus(Command::Type::BusFade, bus, std::clamp(target, 0.f, 1.f), std::max(0.f, seconds));
+}
+
+void AudioManager::SetBusVolume(AudioBus bus, float v) {
+    m_busVolume[busIndex(bus)] = std::clamp(v, 0.f, 1.f);
+    postBus(Command::Type::BusVolume, bus, m_busVolume[busIndex(bus)]);
+}
+
+void AudioManager::SetBusLowPass(AudioBus bus, float cutoffHz) { postBus(Command::Type::BusLowPass, bus, std::max(0.f, cutoffHz)); }
+void AudioManager::SetBusReverb(AudioBus bus, float wet) { postBus(Command::Type::BusReverb, bus, std::clamp(wet, 0.f, 1.f)); }
+
+void AudioManager::applyInsert(const Command& c) {
+    const AudioBus bus = static_cast<AudioBus>(c.index);
+    const auto set = [&c](BusEffects& effects) {
+        if (c.type == Command::Type::BusLowPass) effects.SetLowPass(c.x);
+        else effects.SetReverb(c.x);
+    };
+
+    if (bus == AudioBus::Master) {
+        std::cerr << "Warning: the Master bus has no insert effects" << std::endl;
+        return;
     }
+    if (bus == AudioBus::Music) set(m_music.Effects());
+    if (m_mixer) set(m_mixer->Effects(static_cast<AudioCategory>(c.index - 1)));
+    else if (bus != AudioBus::Music) std::cerr << "Warning: bus insert effects need software mixing" << std::endl;
 }
 
-void AudioManager::StopMusic() {
-    neutralMusic.stop();
-    crazyMusic.stop();
-    isCrossfading = false;
-    crossfadeTimer = 0.f;
-    m_targetTrack = m_currentTrack;
+std::string AudioManager::InsertsSummary() const {
+    static const char* const names[AUDIO_BUS_COUNT] = { "Master", "Music", "Bg", "Dialogue", "Fx" };
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    for (std::size_t b = busIndex(AudioBus::Music); b < AUDIO_BUS_COUNT; ++b) {
+        float lowPass = 0.f;
+        float reverb = 0.f;
+        if (m_mixer) {
+            const BusEffects& effects = m_mixer->Effects(static_cast<AudioCategory>(b - 1));
+            lowPass += effects.LowPassMicroseconds();
+            reverb += effects.ReverbMicroseconds();
+        }
+        if (b == busIndex(AudioBus::Music)) {
+            lowPass += m_music.Effects().LowPassMicroseconds();
+            reverb += m_music.Effects().ReverbMicroseconds();
+        }
+        if (lowPass <= 0.f && reverb <= 0.f) continue;
+        out << (out.tellp() > 0 ? ", " : "Inserts us/block: ") << names[b];
+        if (lowPass > 0.f) out << " LP " << lowPass;
+        if (reverb > 0.f) out << " Rev " << reverb;
+    }
+    return out.tellp() > 0 ? out.str() : std::string("Inserts off");
+}
+
+AudioEmitter* AudioManager::get(EmitterHandle h) {
+    if (!h || h.index >= m_slots.size()) return nullptr;
+    EmitterSlot& slot = m_slots[h.index];
+    return slot.generation == h.generation ? slot.emitter.get() : nullptr;
+}
+
+const AudioEmitter* AudioManager::Find(EmitterHandle h) const {
+    if (!h || h.index >= m_slots.size()) return nullptr;
+    const EmitterSlot& slot = m_slots[h.index];
+    return slot.generation == h.generation ? slot.emitter.get() : nullptr;
+}
+
+EmitterHandle AudioManager::AddEmitter(std::unique_ptr<AudioEmitter> e) {
+    if (!e) return {};
+
+    std::uint32_t index;
+    if (!m_freeSlots.empty()) {
+        index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else {
+        index = static_cast<std::uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+    EmitterSlot& slot = m_slots[index];
+    slot.emitter = std::move(e);
+    slot.resident = slot.emitter->buffer;
+
+    Command c;
+    c.type = Command::Type::AddEmitter;
+    c.emitter = slot.emitter.get();
+    c.x = slot.emitter->position.x;
+    c.y = slot.emitter->position.y;
+    post(c);
+    return { index, slot.generation };
+}
+
+void AudioManager::RemoveEmitter(EmitterHandle h) {
+    AudioEmitter* e = get(h);
+    if (!e) return;
+    Detach(h);
+
+    Command c;
+    c.type = Command::Type::RemoveEmitter;
+    c.emitter = e;
+    post(c);
+
+    EmitterSlot& slot = m_slots[h.index];
+    slot.resident.reset();
+    slot.playPending = false;
+    m_retired.emplace_back(m_commandsPosted, std::move(slot.emitter));
+    if (++slot.generation == 0) slot.generation = 1;
+    m_freeSlots.push_back(h.index);
 }
 
-void AudioManager::PauseMusic() {
-    if (neutralMusic.getStatus() == sf::Music::Playing) neutralMusic.pause();
-    if (crazyMusic.getStatus() == sf::Music::Playing) crazyMusic.pause();
+bool AudioManager::IsLoaded(EmitterHandle h) const {
+    const AudioEmitter* e = Find(h);
+    return e && (m_slots[h.index].resident || !e->sound.empty());
 }
 
-void AudioManager::ResumeMusic() {
-    sf::Music* cur = musicForTrack(m_currentTrack);
-    if (cur->getStatus() == sf::Music::Paused) {
-        cur->play(); // resumes playback
-        applyMusicVolumes();
+void AudioManager::Play(EmitterHandle h) {
+    AudioEmitter* e = get(h);
+    if (!e) return;
+    EmitterSlot& slot = m_slots[h.index];
+    if (!slot.resident && !e->sound.empty()) {
+        // Played before it came near enough to be prefetched: decode off
+        // the main thread and let updateResidency start it
+        SoundBank& bank = SoundBank::Shared();
+        if (!bank.Resident(e->sound)) {
+            bank.Prefetch(e->sound);
+            slot.playPending = !bank.Failed(e->sound);
+            return;
+        }
+        postBuffer(slot, bank.Acquire(e->sound));
     }
+    if (slot.resident) postEmitter(Command::Type::Play, *e, sf::SoundSource::Playing);
 }
 
-void AudioManager::RegisterEmitter(std::shared_ptr<AudioEmitter> e) {
-    emitters.push_back(e);
+void AudioManager::Stop(EmitterHandle h) {
+    AudioEmitter* e = get(h);
+    if (!e) return;
+    m_slots[h.index].playPending = false;
+    postEmitter(Command::Type::Stop, *e, sf::SoundSource::Stopped);
 }
 
-void AudioManager::UnregisterEmitter(const std::string& id) {
-    emitters.erase(std::remove_if(emitters.begin(), emitters.end(),
-        [&](const std::shared_ptr<AudioEmitter>& em) { return em->id == id; }), emitters.end());
+void AudioManager::Pause(EmitterHandle h) {
+    AudioEmitter* e = get(h);
+    if (!e) return;
+    const sf::SoundSource::Status s = GetStatus(h);
+    postEmitter(Command::Type::Pause, *e, s == sf::SoundSource::Playing ? sf::SoundSource::Paused : s);
+}
+
+void AudioManager::Resume(EmitterHandle h) {
+    AudioEmitter* e = get(h);
+    if (!e) return;
+    const sf::SoundSource::Status s = GetStatus(h);
+    postEmitter(Command::Type::Resume, *e, s == sf::SoundSource::Paused ? sf::SoundSource::Playing : s);
+}
+
+sf::SoundSource::Status AudioManager::GetStatus(EmitterHandle h) const {
+    const AudioEmitter* e = Find(h);
+    return e ? status(*e) : sf::SoundSource::Stopped;
+}
+
+sf::SoundSource::Status AudioManager::status(const AudioEmitter& e) {
+    if (e.commandsApplied.load(std::memory_order_acquire) != e.commandsPosted) return e.expectedStatus;
+    return static_cast<sf::SoundSource::Status>(e.publishedStatus.load(std::memory_order_relaxed));
+}
+
+void AudioManager::postPosition(AudioEmitter& e, const b2Vec2& position) {
+    e.position = position;
+    Command c;
+    c.type = Command::Type::Position;
+    c.emitter = &e;
+    c.x = position.x;
+    c.y = position.y;
+    post(c);
+}
+
+void AudioManager::postBuffer(EmitterSlot& slot, std::shared_ptr<const sf::SoundBuffer> buffer) {
+    slot.resident = buffer;
+    Command c;
+    c.type = Command::Type::Buffer;
+    c.emitter = slot.emitter.get();
+    c.buffer = std::move(buffer);
+    post(c);
+}
+
+void AudioManager::updateResidency(const b2Vec2& listenerPos) {
+    // Emitters coming within range prefetch their sound; stopped ones far
+    // out of range hand their buffer back so the bank may evict it
+    SoundBank& bank = SoundBank::Shared();
+    for (EmitterSlot& slot : m_slots) {
+        AudioEmitter* e = slot.emitter.get();
+        if (!e || e->sound.empty()) continue;
+        const float distance = (e->position - listenerPos).Length();
+        const float reach = e->maxDistance + PREFETCH_MARGIN;
+
+        if (!slot.resident) {
+            if (bank.Failed(e->sound)) {
+                slot.playPending = false;
+                continue;
+            }
+            if (distance > reach && !slot.playPending) continue;
+            if (!bank.Resident(e->sound)) {
+                bank.Prefetch(e->sound);
+                continue;
+            }
+            postBuffer(slot, bank.Acquire(e->sound));
+            if (slot.playPending && slot.resident) postEmitter(Command::Type::Play, *e, sf::SoundSource::Playing);
+            slot.playPending = false;
+        }
+        else if (distance > reach + RELEASE_MARGIN && status(*e) == sf::SoundSource::Stopped) {
+            postBuffer(slot, nullptr);
+        }
+    }
+    bank.Pump();
+}
+
+void AudioManager::SetPosition(EmitterHandle h, const b2Vec2& position) {
+    AudioEmitter* e = get(h);
+    if (!e) return;
+    Detach(h);
+    postPosition(*e, position);
+}
+
+b2Vec2 AudioManager::GetPosition(EmitterHandle h) const {
+    const AudioEmitter* e = Find(h);
+    return e ? e->position : b2Vec2(0.f, 0.f);
+}
+
+AudioManager::Attachment* AudioManager::attach(EmitterHandle h) {
+    if (!get(h)) return nullptr;
+    EmitterSlot& slot = m_slots[h.index];
+    if (slot.attachment < 0) {
+        slot.attachment = static_cast<int>(m_attachments.size());
+        m_attachments.emplace_back();
+    }
+    Attachment& a = m_attachments[static_cast<std::size_t>(slot.attachment)];
+    a = Attachment();
+    a.slot = h.index;
+    return &a;
+}
+
+void AudioManager::AttachToBody(EmitterHandle h, const b2Body* body, const b2Vec2& localOffset) {
+    if (!body) { Detach(h); return; }
+    if (Attachment* a = attach(h)) {
+        a->body = body;
+        a->offset = localOffset;
+    }
+}
+
+void AudioManager::AttachToSprite(EmitterHandle h, const sf::Transformable* sprite, float pixelsPerMeter) {
+    if (!sprite) { Detach(h); return; }
+    if (Attachment* a = attach(h)) {
+        a->sprite = sprite;
+        a->metersPerPixel = 1.f / std::max(1e-4f, pixelsPerMeter);
+    }
+}
+
+void AudioManager::Detach(EmitterHandle h) {
+    if (!get(h)) return;
+    EmitterSlot& slot = m_slots[h.index];
+    if (slot.attachment < 0) return;
+
+    // Swap-remove keeps the array packed for Update's pass
+    const std::size_t i = static_cast<std::size_t>(slot.attachment);
+    if (i + 1 != m_attachments.size()) {
+        m_attachments[i] = m_attachments.back();
+        m_slots[m_attachments[i].slot].attachment = static_cast<int>(i);
+    }
+    m_attachments.pop_back();
+    slot.attachment = -1;
 }
 
 void AudioManager::CrossfadeToNeutral() {
-    if (isCrossfading && m_targetTrack == MusicTrack::Neutral) return;
-    if (!isCrossfading && m_currentTrack == MusicTrack::Neutral) return;
-    StartCrossfade(MusicTrack::Neutral);
+    Command c;
+    c.type = Command::Type::Crossfade;
+    c.index = static_cast<int>(MusicTrack::Neutral);
+    post(c);
 }
 
 void AudioManager::CrossfadeToCrazy() {
-    if (isCrossfading && m_targetTrack == MusicTrack::Crazy) return;
-    if (!isCrossfading && m_currentTrack == MusicTrack::Crazy) return;
-    StartCrossfade(MusicTrack::Crazy);
+    Command c;
+    c.type = Command::Type::Crossfade;
+    c.index = static_cast<int>(MusicTrack::Crazy);
+    post(c);
 }
 
-void AudioManager::SetMasterVolume(float v) { masterVolume = std::clamp(v, 0.f, 1.f); applyMusicVolumes(); }
-void AudioManager::SetMusicVolume(float v) { musicVolume = std::clamp(v, 0.f, 1.f); applyMusicVolumes(); }
-void AudioManager::SetBackgroundVolume(float v) { backgroundVolume = std::clamp(v, 0.f, 1.f); }
-void AudioManager::SetDialogueVolume(float v) { dialogueVolume = std::clamp(v, 0.f, 1.f); }
-void AudioManager::SetEffectsVolume(float v) { effectsVolume = std::clamp(v, 0.f, 1.f); }
-
-void AudioManager::SetCrossfadeTime(float t) { crossfadeTime = std::max(0.01f, t); }
+void AudioManager::SetCrossfadeTime(float t) {
+    Command c;
+    c.type = Command::Type::CrossfadeTime;
+    c.x = std::max(0.01f, t);
+    post(c);
+}
 
 void AudioManager::Update(float dt, const b2Vec2& listenerPos) {
-    updateCrossfade(dt);
+    Command listener;
+    listener.type = Command::Type::Listener;
+    listener.x = listenerPos.x;
+    listener.y = listenerPos.y;
+    post(listener);
+
+    // One pass over every attachment, straight from the body transforms and
+    // sprite positions; only emitters that moved cost a command
+    for (const Attachment& a : m_attachments) {
+        b2Vec2 p;
+        if (a.body) {
+            p = b2Mul(a.body->GetTransform(), a.offset);
+        }
+        else {
+            const sf::Vector2f& px = a.sprite->getPosition();
+            p.Set(px.x * a.metersPerPixel, px.y * a.metersPerPixel);
+        }
+        AudioEmitter& e = *m_slots[a.slot].emitter;
+        if (p.x != e.position.x || p.y != e.position.y) postPosition(e, p);
+    }
 
-    for (auto& e : emitters) {
-        float distance = (e->position - listenerPos).Length();
-        float targetGain = ComputeGain(distance, e->minDistance, e->maxDistance);
-        float alpha = 1.f - std::exp(-dt / std::max(0.0001f, settings.smoothingTime));
-        e->currentGain = e->currentGain + (targetGain - e->currentGain) * alpha;
+    updateResidency(listenerPos);
 
-        float categoryMultiplier = GetCategoryMultiplier(e->category);
-        float finalVolume = e->baseVolume * e->currentGain * categoryMultiplier * masterVolume;
-        e->applyVolume(finalVolume);
+    const std::uint64_t applied = m_commandsApplied.load(std::memory_order_acquire);
+    m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(),
+        [&](const auto& r) { return r.first <= applied; }), m_retired.end());
+
+    if (!Threaded()) tick(dt);
+}
+
+void AudioManager::tick(float dt) {
+    updateFades(dt);
+    if (!m_musicPaused) updateCrossfade(dt);
+    if (busGain(AudioBus::Music) != m_musicGain) applyMusicVolumes();
+
+    // Per-tick constants: one exp for every emitter, category volumes folded with master
+    const float alpha = 1.f - std::exp(-dt / std::max(0.0001f, settings.smoothingTime));
+    std::array<float, AUDIO_CATEGORY_COUNT> categoryVolume;
+    for (std::size_t c = 0; c < AUDIO_CATEGORY_COUNT; ++c)
+        categoryVolume[c] = busGain(BusFor(static_cast<AudioCategory>(c)));
+
+    // Stopped emitters cost nothing: no distance, no smoothing, no OpenAL call.
+    // One that just started snaps to its gain instead of fading in from a stale value.
+    m_batch.Clear();
+    for (AudioEmitter* e : m_mixEmitters) {
+        if (e->instances.empty()) {
+            e->active = false;
+            e->finalVolume = 0.f; // a new play() waits for its first real gain
+            continue;
+        }
+        m_batch.Push(*e, e->baseVolume * categoryVolume[static_cast<std::size_t>(e->category)], e->active ? alpha : 1.f);
+        e->active = true;
     }
+
+    EvaluateGains(m_batch, m_listener.x, m_listener.y,
+        DistanceLut::For(settings.distanceModel), std::clamp(settings.panStrength, 0.f, 1.f));
+
+    for (std::size_t i = 0; i < m_batch.Size(); ++i) {
+        AudioEmitter& e = *m_batch.emitters[i];
+        e.currentGain = m_batch.gain[i];
+        e.finalVolume = m_batch.finalVolume[i];
+        e.pan = m_batch.pan[i];
+        if (!e.busPaused) e.advance(dt);
+        // One-shots that ran out show up as Stopped for the game thread
+        e.publishedStatus.store(e.mixStatus(), std::memory_order_relaxed);
+    }
+
+    // Hand voices to the instances that matter most and push volumes that moved
+    m_voices.Update(m_batch.emitters);
 }
 
 void AudioManager::PrintVolumes() {
-    std::cout << "Master: " << masterVolume
-        << " Music: " << musicVolume
-        << " BG: " << backgroundVolume
-        << " Dialogue: " << dialogueVolume
-        << " Effects: " << effectsVolume << std::endl;
+    std::cout << "Master: " << GetMasterVolume()
+        << " Music: " << GetMusicVolume()
+        << " BG: " << GetBackgroundVolume()
+        << " Dialogue: " << GetDialogueVolume()
+        << " Effects: " << GetEffectsVolume() << std::endl;
 }
 
-sf::Music* AudioManager::musicForTrack(MusicTrack t) {
-    return (t == MusicTrack::Neutral) ? &neutralMusic : &crazyMusic;
+void AudioManager::updateFades(float dt) {
+    for (Bus& bus : m_buses) {
+        if (bus.fade == bus.fadeTarget) continue;
+        const float step = bus.fadeRate * dt;
+        bus.fade = (bus.fade < bus.fadeTarget) ? std::min(bus.fadeTarget, bus.fade + step)
+            : std::max(bus.fadeTarget, bus.fade - step);
+    }
 }
 
-void AudioManager::StartCrossfade(MusicTrack target) {
-    sf::Music* targetMusic = musicForTrack(target);
-    sf::Music* sourceMusic = musicForTrack(m_currentTrack);
+bool AudioManager::busPaused(AudioBus bus) const {
+    return m_buses[busIndex(AudioBus::Master)].paused || m_buses[busIndex(bus)].paused;
+}
+
+float AudioManager::busGain(AudioBus bus) const {
+    const float master = m_buses[busIndex(AudioBus::Master)].Gain();
+    return bus == AudioBus::Master ? master : master * m_buses[busIndex(bus)].Gain();
+}
 
-    // Ensure both are playing for crossfade
-    if (sourceMusic->getStatus() != sf::Music::Playing) {
-        sourceMusic->play();
-        sourceMusic->setVolume(masterVolume * musicVolume * 100.f);
+void AudioManager::applyBusPause() {
+    // Only voices that are actually sounding are held, so each instance's own
+    // pause state survives a bus pause/resume untouched
+    for (AudioEmitter* e : m_mixEmitters) {
+        const bool paused = busPaused(BusFor(e->category));
+        if (paused == e->busPaused) continue;
+        e->busPaused = paused;
+        for (EmitterInstance& inst : e->instances) {
+            if (inst.voice < 0 || inst.paused) continue;
+            if (paused) m_voices.PauseVoice(inst.voice);
+            else m_voices.ResumeVoice(inst.voice);
+        }
     }
-    if (targetMusic->getStatus() != sf::Music::Playing) {
-        targetMusic->play();
-        targetMusic->setVolume(0.f);
+
+    const bool musicPaused = busPaused(AudioBus::Music);
+    if (musicPaused == m_musicPaused) return;
+    m_musicPaused = musicPaused;
+    if (musicPaused) {
+        if (m_music.getStatus() == sf::Music::Playing) {
+            m_music.pause();
+            m_musicHeld = true;
+        }
+    }
+    else if (m_musicHeld) {
+        m_music.play(); // resumes playback
+        m_musicHeld = false;
     }
+}
 
+void AudioManager::playMusic() {
+    // While the music bus is paused the stream starts on resume
+    if (m_musicPaused) m_musicHeld = true;
+    else m_music.play();
+}
+
+void AudioManager::StartCrossfade(MusicTrack target) {
+    // The stems already play in step; a crossfade only moves their gains
     isCrossfading = true;
     crossfadeTimer = 0.f;
     m_targetTrack = target;
@@ -149,40 +656,17 @@ void AudioManager::updateCrossfade(float dt) {
     float t = std::clamp(crossfadeTimer / crossfadeTime, 0.f, 1.f);
     float smoothT = t * t * (3.f - 2.f * t);
 
-    sf::Music* targetMusic = musicForTrack(m_targetTrack);
-    sf::Music* sourceMusic = musicForTrack(m_currentTrack);
-
-    float sourceVol = (1.f - smoothT) * masterVolume * musicVolume * 100.f;
-    float targetVol = (smoothT)*masterVolume * musicVolume * 100.f;
-
-    sourceMusic->setVolume(sourceVol);
-    targetMusic->setVolume(targetVol);
+    m_music.SetStemGain(stemFor(m_currentTrack), 1.f - smoothT);
+    m_music.SetStemGain(stemFor(m_targetTrack), smoothT);
 
     if (t >= 1.f - 1e-6f) {
         isCrossfading = false;
-        if (sourceMusic != targetMusic) sourceMusic->stop();
         m_currentTrack = m_targetTrack;
     }
 }
 
-float AudioManager::ComputeGain(float distanceMeters, float minD, float maxD) {
-    if (distanceMeters <= minD) return 1.f;
-    if (distanceMeters >= maxD) return 0.f;
-    return 1.f - (distanceMeters - minD) / (maxD - minD);
-}
-
-float AudioManager::GetCategoryMultiplier(AudioCategory cat) const {
-    switch (cat) {
-    case AudioCategory::Music: return musicVolume;
-    case AudioCategory::Background: return backgroundVolume;
-    case AudioCategory::Dialogue: return dialogueVolume;
-    case AudioCategory::Effects: return effectsVolume;
-    default: return 1.f;
-    }
-}
-
 void AudioManager::applyMusicVolumes() {
-    if (!isCrossfading) {
-        musicForTrack(m_currentTrack)->setVolume(masterVolume * musicVolume * 100.f);
-    }
+    // Bus gain on the stream; the crossfade is in the stem gains
+    m_musicGain = busGain(AudioBus::Music);
+    m_music.setVolume(m_musicGain * 100.f);
 }
\ No newline at end of file
@@ -2,68 +2,238 @@
 #define AUDIO_MANAGER_H
 
 #include "AudioEmitter.h"
+#include "VoicePool.h"
+#include "AudioBatch.h"
+#include "SpscQueue.h"
+#include "AdaptiveMusicStream.h"
+#include <array>
 #include <SFML/Audio.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
 #include <vector>
 #include <memory>
 #include <algorithm>
 #include <cmath>
 
-enum class DistanceModelEnum { Linear, InverseSquare, Logarithmic };
+// Names an emitter owned by AudioManager. Slots are reused, so the
+// generation tells a live emitter from one removed earlier; calls with a
+// stale or empty handle do nothing.
+struct EmitterHandle {
+    std::uint32_t index = 0;
+    std::uint32_t generation = 0; // 0 never names an emitter
+
+    explicit operator bool() const { return generation != 0; }
+    bool operator==(const EmitterHandle&) const = default;
+};
 
 struct AudioSettings {
     DistanceModelEnum distanceModel = DistanceModelEnum::Linear;
     float smoothingTime = 0.08f; // seconds for emitter smoothing
+    float panStrength = 0.8f;    // 0 = mono, 1 = hard left/right for emitters fully to the side
 };
 
+// Everything below is called from the game thread. Once StartThread() has
+// run, calls become commands in a lock-free queue and return at once; the
+// audio thread drains it TICK_RATE times a second and does the OpenAL work,
+// gain smoothing and music crossfades there, whatever the frame rate. Before
+// that (or after StopThread) commands are applied on the spot.
 class AudioManager {
 public:
+    static constexpr float TICK_RATE = 100.f; // audio thread ticks per second
+    // Meters beyond an emitter's maxDistance at which its bank sound is
+    // prefetched, and further still before a stopped emitter lets it go
+    static constexpr float PREFETCH_MARGIN = 5.f;
+    static constexpr float RELEASE_MARGIN = 5.f;
+
     AudioManager();
-    ~AudioManager() = default;
+    ~AudioManager();
+
+    AudioManager(const AudioManager&) = delete;
+    AudioManager& operator=(const AudioManager&) = delete;
+
+    // Load music first; once the thread runs it owns the music
+    void StartThread();
+    void StopThread();
+    bool Threaded() const { return m_thread.joinable(); }
+
+    // Play every voice through one SoftwareMixer stream instead of an OpenAL
+    // source per sound; `voices` becomes the pool's capacity. Only before
+    // StartThread and while nothing plays.
+    bool EnableSoftwareMixer(unsigned voices);
+    const SoftwareMixer* Mixer() const { return m_mixer.get(); } // null on the sf::Sound path
 
     // music loader
     bool loadMusic(const std::string& neutralPath, const std::string& crazyPath);
 
     // explicit music playback control
-    void StartMusic();   // start current track (neutral by default)
-    void StopMusic();    // stop both tracks
-    void PauseMusic();   // pause both tracks
-    void ResumeMusic();  // resume current track
+    void StartMusic();   // start from the top on the current track (neutral by default)
+    void StopMusic();
+    void PauseMusic() { PauseBus(AudioBus::Music); }
+    void ResumeMusic() { ResumeBus(AudioBus::Music); }
+
+    // Buses. Pausing holds every voice and music track under the bus where
+    // it is (pausing Master holds everything); resuming restarts only what
+    // was playing, so emitters that were paused or stopped on their own
+    // stay that way. Mute and fades scale the bus on top of its volume.
+    void PauseBus(AudioBus bus);
+    void ResumeBus(AudioBus bus);
+    void SetBusMuted(AudioBus bus, bool muted);
+    // Linear fade of the bus's fade gain to `target` (0..1) over `seconds`
+    void FadeBus(AudioBus bus, float target, float seconds);
+    void SetBusVolume(AudioBus bus, float v);
+    float GetBusVolume(AudioBus bus) const { return m_busVolume[busIndex(bus)]; }
+
+    // Insert effects, run by the stream that mixes the bus: the music
+    // stream for Music, the software mixer for the others (so those need
+    // EnableSoftwareMixer). Master has none. Low-pass cutoff in Hz, 0 takes
+    // the filter out; reverb wet 0..1. Both glide to the new setting.
+    void SetBusLowPass(AudioBus bus, float cutoffHz);
+    void SetBusReverb(AudioBus bus, float wet);
+    // Stream thread time of each running insert per block, for the overlay
+    std::string InsertsSummary() const;
+
+    // Emitters. Set up the sound (loadBuffer) or buffer, category,
+    // distances, volume and limits, then hand the emitter over; it plays
+    // through the voice pool until RemoveEmitter, which stops it. A bank
+    // sound is decoded as the emitter nears the listener and handed back
+    // once it is stopped and far away. Play on one that is not resident
+    // starts the decode on the bank's worker and plays once it is in, so
+    // the sound starts a frame or more late instead of stalling this one.
+    EmitterHandle AddEmitter(std::unique_ptr<AudioEmitter> e);
+    void RemoveEmitter(EmitterHandle h);
+    const AudioEmitter* Find(EmitterHandle h) const; // nullptr once removed
+    bool IsLoaded(EmitterHandle h) const;
+
+    // Play starts a new, overlapping instance from the beginning
+    void Play(EmitterHandle h);
+    void Stop(EmitterHandle h);
+    void Pause(EmitterHandle h);
+    void Resume(EmitterHandle h);
+    // Playing if any instance is running, Paused if all are paused
+    sf::SoundSource::Status GetStatus(EmitterHandle h) const;
+
+    // Moves the emitter (and detaches it); sent right away
+    void SetPosition(EmitterHandle h, const b2Vec2& position);
+    b2Vec2 GetPosition(EmitterHandle h) const;
+    // Follow a body (offset in body space, meters) or a sprite (pixels).
+    // Update reads all attachments in one pass and sends the emitters that
+    // moved. The body or sprite has to outlive the attachment.
+    void AttachToBody(EmitterHandle h, const b2Body* body, const b2Vec2& localOffset = b2Vec2(0.f, 0.f));
+    void AttachToSprite(EmitterHandle h, const sf::Transformable* sprite, float pixelsPerMeter);
+    void Detach(EmitterHandle h);
 
-    // emitter control
-    void RegisterEmitter(std::shared_ptr<AudioEmitter> e);
-    void UnregisterEmitter(const std::string& id);
+    // Stats only from the game thread
+    const VoicePool& Voices() const { return m_voices; }
 
     // music crossfade control (driven externally, e.g., by Player state)
     void CrossfadeToNeutral();
     void CrossfadeToCrazy();
 
     // volume setters
-    void SetMasterVolume(float v);
-    void SetMusicVolume(float v);
-    void SetBackgroundVolume(float v);
-    void SetDialogueVolume(float v);
-    void SetEffectsVolume(float v);
-
-    // volume getters (0..1)
-    float GetMasterVolume() const { return masterVolume; }
-    float GetMusicVolume() const { return musicVolume; }
-    float GetBackgroundVolume() const { return backgroundVolume; }
-    float GetDialogueVolume() const { return dialogueVolume; }
-    float GetEffectsVolume() const { return effectsVolume; }
+    void SetMasterVolume(float v) { SetBusVolume(AudioBus::Master, v); }
+    void SetMusicVolume(float v) { SetBusVolume(AudioBus::Music, v); }
+    void SetBackgroundVolume(float v) { SetBusVolume(AudioBus::Background, v); }
+    void SetDialogueVolume(float v) { SetBusVolume(AudioBus::Dialogue, v); }
+    void SetEffectsVolume(float v) { SetBusVolume(AudioBus::Effects, v); }
+
+    // volume getters (0..1), the last values set on the game thread
+    float GetMasterVolume() const { return GetBusVolume(AudioBus::Master); }
+    float GetMusicVolume() const { return GetBusVolume(AudioBus::Music); }
+    float GetBackgroundVolume() const { return GetBusVolume(AudioBus::Background); }
+    float GetDialogueVolume() const { return GetBusVolume(AudioBus::Dialogue); }
+    float GetEffectsVolume() const { return GetBusVolume(AudioBus::Effects); }
 
     void SetCrossfadeTime(float t);
 
+    // Once per frame: sends the listener and attached emitters, moves bank
+    // sounds in and out of residency and frees emitters the audio thread
+    // has let go of. Without the thread this also runs the mix tick.
     void Update(float dt, const b2Vec2& listenerPos);
     void PrintVolumes();
 
+    // Read by the audio thread; set before StartThread
     AudioSettings settings;
 
 private:
-    // music
-    sf::Music neutralMusic;
-    sf::Music crazyMusic;
+    struct Command {
+        enum class Type : std::uint8_t {
+            AddEmitter, RemoveEmitter, Play, Stop, Pause, Resume, Position, Buffer, Listener,
+            BusVolume, BusPause, BusResume, BusMute, BusFade, BusLowPass, BusReverb,
+            CrossfadeTime, StartMusic, StopMusic, Crossfade
+        };
+        Type type = Type::Play;
+        AudioEmitter* emitter = nullptr;
+        float x = 0.f; // position, volume, fade target or time
+        float y = 0.f; // position or fade time
+        int index = 0; // Bus*: AudioBus; BusMute: 0/1 in x; Crossfade: MusicTrack
+        std::shared_ptr<const sf::SoundBuffer> buffer; // Buffer; null drops it
+    };
+
+    // Audio thread state of one bus
+    struct Bus {
+        float volume = 1.f;
+        float fade = 1.f;
+        float fadeTarget = 1.f;
+        float fadeRate = 0.f; // per second
+        bool muted = false;
+        bool paused = false;
+        float Gain() const { return muted ? 0.f : volume * fade; }
+    };
 
     enum class MusicTrack { Neutral, Crazy };
+
+    struct EmitterSlot {
+        std::unique_ptr<AudioEmitter> emitter; // null while free
+        std::uint32_t generation = 1;
+        int attachment = -1; // index into m_attachments
+        std::shared_ptr<const sf::SoundBuffer> resident; // the buffer the audio thread was last sent
+        bool playPending = false; // Play arrived before the sound was resident
+    };
+
+    // Either body or sprite is set
+    struct Attachment {
+        std::uint32_t slot = 0;
+        const b2Body* body = nullptr;
+        const sf::Transformable* sprite = nullptr;
+        b2Vec2 offset = { 0.f, 0.f }; // body space, meters
+        float metersPerPixel = 1.f;
+    };
+
+    static std::size_t busIndex(AudioBus bus) { return static_cast<std::size_t>(bus); }
+
+    void post(const Command& c);
+    AudioEmitter* get(EmitterHandle h);
+    void postEmitter(Command::Type type, AudioEmitter& e, sf::SoundSource::Status expected);
+    static sf::SoundSource::Status status(const AudioEmitter& e); // GetStatus without the handle
+    void postPosition(AudioEmitter& e, const b2Vec2& position);
+    void postBuffer(EmitterSlot& slot, std::shared_ptr<const sf::SoundBuffer> buffer);
+    void updateResidency(const b2Vec2& listenerPos);
+    Attachment* attach(EmitterHandle h);
+    void postBus(Command::Type type, AudioBus bus, float x = 0.f, float y = 0.f);
+
+    // audio thread (or the caller while there is none)
+    void threadMain();
+    void drainCommands();
+    void apply(const Command& c);
+    void tick(float dt);
+    void updateFades(float dt);
+    void applyBusPause();
+    void applyInsert(const Command& c);
+    bool busPaused(AudioBus bus) const;
+    float busGain(AudioBus bus) const; // including Master
+
+    SpscQueue<Command, 4096> m_commands;
+    std::thread m_thread;
+    std::atomic<bool> m_threadRunning{ false };
+    std::uint64_t m_commandsPosted = 0;                 // game thread
+    std::atomic<std::uint64_t> m_commandsApplied{ 0 };  // audio thread
+
+    // Both tracks are stems of one stream (audio thread once loaded)
+    AdaptiveMusicStream m_music;
+
     MusicTrack m_currentTrack = MusicTrack::Neutral;
     MusicTrack m_targetTrack = MusicTrack::Neutral;
 
@@ -71,21 +241,32 @@ private:
     float crossfadeTimer = 0.f;
     bool isCrossfading = false;
 
-    // mixer volumes
-    float masterVolume;
-    float musicVolume;
-    float backgroundVolume;
-    float dialogueVolume;
-    float effectsVolume;
+    bool m_musicHeld = false; // a bus pause stopped it, or it was started while paused
+    bool m_musicPaused = false;
+    float m_musicGain = -1.f; // last bus gain applied to the stream
+
+    std::array<float, AUDIO_BUS_COUNT> m_busVolume; // game thread copies for the getters
+    std::array<Bus, AUDIO_BUS_COUNT> m_buses;       // what the mix uses (audio thread)
+    b2Vec2 m_listener = { 0.f, 0.f };
 
-    std::vector<std::shared_ptr<AudioEmitter>> emitters;
+    // voices outlive the emitters that borrow them (see ~AudioManager), the
+    // mixer outlives the pool that feeds it
+    std::unique_ptr<SoftwareMixer> m_mixer;
+    VoicePool m_voices;
+    // Game thread ownership. Removed emitters stay alive in m_retired until
+    // the audio thread has applied the command that drops them.
+    std::vector<EmitterSlot> m_slots;
+    std::vector<std::uint32_t> m_freeSlots;
+    std::vector<Attachment> m_attachments; // packed for the per-frame pass
+    std::vector<std::pair<std::uint64_t, std::unique_ptr<AudioEmitter>>> m_retired;
+    std::vector<AudioEmitter*> m_mixEmitters; // audio thread's view of m_slots
+    EmitterBatch m_batch; // playing emitters, rebuilt every tick
 
-    sf::Music* musicForTrack(MusicTrack t);
+    static std::size_t stemFor(MusicTrack t) { return static_cast<std::size_t>(t); }
     void StartCrossfade(MusicTrack target);
+    void playMusic();
     void updateCrossfade(float dt);
 
-    float ComputeGain(float distanceMeters, float minD, float maxD);
-    float GetCategoryMultiplier(AudioCategory cat) const;
     void applyMusicVolumes();
 };
 
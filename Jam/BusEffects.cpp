@@ -0,0 +1,259 @@
+#include "BusEffects.h"
+#include "MixKernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#ifdef JAM_MIX_SSE
+#include <emmintrin.h>
+#endif
+
+namespace {
+    constexpr float GLIDE_SECONDS = 0.05f;     // low-pass cutoff glide time constant
+    constexpr float WET_GLIDE_SECONDS = 0.25f; // reverb fades in and out this slowly
+    constexpr float TIMING_SMOOTHING = 0.1f;
+    constexpr float PI = 3.14159265f;
+
+    // Delay lengths at 44.1 kHz: mutually prime, 23..42 ms
+    constexpr std::array<std::size_t, FdnReverb::LINES> LINE_LENGTHS = { 1031, 1327, 1523, 1871 };
+    // Input polarity per line, so the first pass through the matrix
+    // spreads over every line instead of piling into one
+    constexpr float INPUT_SIGNS[FdnReverb::LINES] = { 1.f, 1.f, -1.f, 1.f };
+    constexpr float INPUT_GAIN = 0.35f;
+
+    float micros(std::chrono::steady_clock::time_point from)
+    {
+        return std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - from).count();
+    }
+}
+
+// ---- StereoLowPass ----
+
+void StereoLowPass::Prepare(unsigned sampleRate)
+{
+    m_sampleRate = static_cast<float>(std::max(1u, sampleRate));
+    m_cutoff = BYPASS_CUTOFF;
+    std::fill(std::begin(m_z1), std::end(m_z1), 0.f);
+    std::fill(std::begin(m_z2), std::end(m_z2), 0.f);
+}
+
+bool StereoLowPass::Active() const
+{
+    return m_cutoff < BYPASS_CUTOFF || m_target.load(std::memory_order_relaxed) < BYPASS_CUTOFF;
+}
+
+void StereoLowPass::updateCoefficients(float cutoff)
+{
+    const float w0 = 2.f * PI * std::min(cutoff, 0.45f * m_sampleRate) / m_sampleRate;
+    const float cosw = std::cos(w0);
+    const float alpha = std::sin(w0) / (2.f * 0.70710678f);
+    const float a0 = 1.f + alpha;
+    m_b1 = (1.f - cosw) / a0;
+    m_b0 = m_b2 = m_b1 * 0.5f;
+    m_a1 = -2.f * cosw / a0;
+    m_a2 = (1.f - alpha) / a0;
+}
+
+void StereoLowPass::Process(float* stereo, std::size_t frames)
+{
+    const float target = std::clamp(m_target.load(std::memory_order_relaxed), 20.f, BYPASS_CUTOFF);
+    if (m_cutoff >= BYPASS_CUTOFF && target >= BYPASS_CUTOFF) return;
+    if (m_cutoff >= BYPASS_CUTOFF) {
+        // Coming out of bypass: no stale state from the last time it ran
+        std::fill(std::begin(m_z1), std::end(m_z1), 0.f);
+        std::fill(std::begin(m_z2), std::end(m_z2), 0.f);
+    }
+
+    // Glide in octaves (geometrically), a block at a time
+    const float k = 1.f - std::exp(-static_cast<float>(frames) / (m_sampleRate * GLIDE_SECONDS));
+    m_cutoff *= std::pow(target / m_cutoff, k);
+    if (std::abs(m_cutoff - target) < 1.f) m_cutoff = target;
+    if (m_cutoff >= BYPASS_CUTOFF) return; // all but transparent up there; drop out
+    updateCoefficients(m_cutoff);
+
+#ifdef JAM_MIX_SSE
+    const __m128 b0 = _mm_set1_ps(m_b0);
+    const __m128 b1 = _mm_set1_ps(m_b1);
+    const __m128 b2 = _mm_set1_ps(m_b2);
+    const __m128 a1 = _mm_set1_ps(m_a1);
+    const __m128 a2 = _mm_set1_ps(m_a2);
+    __m128 z1 = _mm_load_ps(m_z1);
+    __m128 z2 = _mm_load_ps(m_z2);
+    for (std::size_t f = 0; f < frames; ++f) {
+        __m64* frame = reinterpret_cast<__m64*>(stereo + f * 2);
+        const __m128 x = _mm_loadl_pi(_mm_setzero_ps(), frame);
+        const __m128 y = _mm_add_ps(_mm_mul_ps(b0, x), z1);
+        z1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), z2);
+        z2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+        _mm_storel_pi(frame, y);
+    }
+    _mm_store_ps(m_z1, z1);
+    _mm_store_ps(m_z2, z2);
+#else
+    for (std::size_t f = 0; f < frames; ++f) {
+        for (int c = 0; c < 2; ++c) {
+            float& s = stereo[f * 2 + c];
+            const float x = s;
+            const float y = m_b0 * x + m_z1[c];
+            m_z1[c] = m_b1 * x - m_a1 * y + m_z2[c];
+            m_z2[c] = m_b2 * x - m_a2 * y;
+            s = y;
+        }
+    }
+#endif
+}
+
+// ---- FdnReverb ----
+
+void FdnReverb::Prepare(unsigned sampleRate)
+{
+    const float rate = static_cast<float>(std::max(1u, sampleRate));
+    m_sampleRate = rate;
+    for (std::size_t i = 0; i < LINES; ++i) {
+        const std::size_t length = std::max<std::size_t>(1, static_cast<std::size_t>(LINE_LENGTHS[i] * rate / 44100.f));
+        m_lines[i].assign(length, 0.f);
+        m_cursor[i] = 0;
+        // -60 dB after DECAY_SECONDS, whatever the line's length
+        m_feedback[i] = std::pow(10.f, -3.f * static_cast<float>(length) / (rate * DECAY_SECONDS));
+        m_damped[i] = 0.f;
+    }
+    m_wet = 0.f;
+}
+
+bool FdnReverb::Active() const
+{
+    return m_wet > 0.f || m_target.load(std::memory_order_relaxed) > 0.f;
+}
+
+void FdnReverb::Process(float* stereo, std::size_t frames)
+{
+    const float target = std::clamp(m_target.load(std::memory_order_relaxed), 0.f, 1.f);
+    if (m_wet <= 0.f && target <= 0.f) return;
+    if (m_wet <= 0.f) {
+        // Fresh room; an old tail would come back in mid-decay otherwise
+        for (std::vector<float>& line : m_lines) std::fill(line.begin(), line.end(), 0.f);
+        std::fill(std::begin(m_damped), std::end(m_damped), 0.f);
+    }
+    // Glide towards the target, ramped linearly across this block
+    float next = m_wet + (target - m_wet) * (1.f - std::exp(-static_cast<float>(frames) / (m_sampleRate * WET_GLIDE_SECONDS)));
+    if (std::abs(next - target) < 0.001f) next = target;
+    const float wetStep = (next - m_wet) / static_cast<float>(std::max<std::size_t>(1, frames));
+    float wet = m_wet;
+
+    float* lines[LINES] = { m_lines[0].data(), m_lines[1].data(), m_lines[2].data(), m_lines[3].data() };
+    std::size_t cursor[LINES] = { m_cursor[0], m_cursor[1], m_cursor[2], m_cursor[3] };
+    const std::size_t length[LINES] = { m_lines[0].size(), m_lines[1].size(), m_lines[2].size(), m_lines[3].size() };
+
+#ifdef JAM_MIX_SSE
+    // Hadamard/2 as two butterfly stages, with each line's decay folded in
+    const __m128 sign1 = _mm_setr_ps(1.f, -1.f, 1.f, -1.f);
+    const __m128 sign2 = _mm_setr_ps(1.f, 1.f, -1.f, -1.f);
+    const __m128 gain = _mm_mul_ps(_mm_load_ps(m_feedback), _mm_set1_ps(0.5f));
+    const __m128 inputSigns = _mm_setr_ps(INPUT_SIGNS[0], INPUT_SIGNS[1], INPUT_SIGNS[2], INPUT_SIGNS[3]);
+    const __m128 smooth = _mm_set1_ps(1.f - DAMPING);
+    __m128 damped = _mm_load_ps(m_damped);
+    alignas(16) float writes[LINES];
+
+    for (std::size_t f = 0; f < frames; ++f) {
+        // Gathered in registers: four scalar stores read back as one vector
+        // would miss store forwarding on every frame
+        const float tap0 = lines[0][cursor[0]];
+        const float tap1 = lines[1][cursor[1]];
+        const float tap2 = lines[2][cursor[2]];
+        const float tap3 = lines[3][cursor[3]];
+        const __m128 tap = _mm_setr_ps(tap0, tap1, tap2, tap3);
+        damped = _mm_add_ps(damped, _mm_mul_ps(_mm_sub_ps(tap, damped), smooth));
+
+        const __m128 t = _mm_add_ps(_mm_shuffle_ps(damped, damped, _MM_SHUFFLE(2, 2, 0, 0)),
+            _mm_mul_ps(_mm_shuffle_ps(damped, damped, _MM_SHUFFLE(3, 3, 1, 1)), sign1));
+        const __m128 h = _mm_add_ps(_mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 0, 1, 0)),
+            _mm_mul_ps(_mm_shuffle_ps(t, t, _MM_SHUFFLE(3, 2, 3, 2)), sign2));
+
+        float* frame = stereo + f * 2;
+        const float in = (frame[0] + frame[1]) * INPUT_GAIN;
+        _mm_store_ps(writes, _mm_add_ps(_mm_mul_ps(h, gain), _mm_mul_ps(_mm_set1_ps(in), inputSigns)));
+        for (std::size_t i = 0; i < LINES; ++i) {
+            lines[i][cursor[i]] = writes[i];
+            if (++cursor[i] == length[i]) cursor[i] = 0;
+        }
+
+        wet += wetStep;
+        frame[0] += wet * (tap0 + tap2) * 0.5f;
+        frame[1] += wet * (tap1 + tap3) * 0.5f;
+    }
+    _mm_store_ps(m_damped, damped);
+#else
+    for (std::size_t f = 0; f < frames; ++f) {
+        float taps[LINES];
+        for (std::size_t i = 0; i < LINES; ++i) {
+            taps[i] = lines[i][cursor[i]];
+            m_damped[i] += (taps[i] - m_damped[i]) * (1.f - DAMPING);
+        }
+        const float* d = m_damped;
+        const float h[LINES] = {
+            (d[0] + d[1] + d[2] + d[3]) * 0.5f,
+            (d[0] - d[1] + d[2] - d[3]) * 0.5f,
+            (d[0] + d[1] - d[2] - d[3]) * 0.5f,
+            (d[0] - d[1] - d[2] + d[3]) * 0.5f,
+        };
+        float* frame = stereo + f * 2;
+        const float in = (frame[0] + frame[1]) * INPUT_GAIN;
+        for (std::size_t i = 0; i < LINES; ++i) {
+            lines[i][cursor[i]] = h[i] * m_feedback[i] + in * INPUT_SIGNS[i];
+            if (++cursor[i] == length[i]) cursor[i] = 0;
+        }
+
+        wet += wetStep;
+        frame[0] += wet * (taps[0] + taps[2]) * 0.5f;
+        frame[1] += wet * (taps[1] + taps[3]) * 0.5f;
+    }
+#endif
+
+    for (std::size_t i = 0; i < LINES; ++i) m_cursor[i] = cursor[i];
+    m_wet = next;
+}
+
+// ---- BusEffects ----
+
+void BusEffects::Prepare(unsigned sampleRate)
+{
+    m_lowPass.Prepare(sampleRate);
+    m_reverb.Prepare(sampleRate);
+}
+
+void BusEffects::SetLowPass(float cutoffHz)
+{
+    m_lowPass.SetCutoff(cutoffHz <= 0.f ? StereoLowPass::BYPASS_CUTOFF : std::min(cutoffHz, StereoLowPass::BYPASS_CUTOFF));
+}
+
+void BusEffects::SetReverb(float wet)
+{
+    m_reverb.SetWet(std::clamp(wet, 0.f, 1.f));
+}
+
+void BusEffects::Process(float* stereo, std::size_t frames)
+{
+#ifdef JAM_MIX_SSE
+    // Decaying filter and reverb state goes denormal in silence, which is
+    // many times slower on x86; flush it to zero while the effects run
+    const unsigned int csr = _mm_getcsr();
+    _mm_setcsr(csr | 0x8040); // FTZ | DAZ
+#endif
+
+    const auto timed = [](std::atomic<float>& average, bool active, auto&& run) {
+        if (!active) {
+            average.store(0.f, std::memory_order_relaxed);
+            return;
+        }
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const float last = average.load(std::memory_order_relaxed);
+        average.store(last + (micros(start) - last) * TIMING_SMOOTHING, std::memory_order_relaxed);
+    };
+    timed(m_lowPassMicros, m_lowPass.Active(), [&] { m_lowPass.Process(stereo, frames); });
+    timed(m_reverbMicros, m_reverb.Active(), [&] { m_reverb.Process(stereo, frames); });
+
+#ifdef JAM_MIX_SSE
+    _mm_setcsr(csr);
+#endif
+}
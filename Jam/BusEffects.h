@@ -0,0 +1,81 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Insert effects on one audio bus, run by the stream that mixes the bus
+// (SoftwareMixer per category, AdaptiveMusicStream for music). Buffers
+// are interleaved stereo floats. Parameters are atomics any thread may
+// set; the stream thread glides to them, so changes never click.
+
+// 12 dB/octave low-pass (RBJ biquad, Butterworth Q), both channels in
+// one SSE register
+class StereoLowPass {
+public:
+    static constexpr float BYPASS_CUTOFF = 20000.f; // at or above: off
+
+    void Prepare(unsigned sampleRate);
+    void SetCutoff(float hz) { m_target.store(hz, std::memory_order_relaxed); }
+    bool Active() const;
+    void Process(float* stereo, std::size_t frames);
+
+private:
+    void updateCoefficients(float cutoff);
+
+    std::atomic<float> m_target{ BYPASS_CUTOFF };
+    float m_cutoff = BYPASS_CUTOFF; // stream thread: current, gliding towards m_target
+    float m_sampleRate = 44100.f;
+    float m_b0 = 1.f, m_b1 = 0.f, m_b2 = 0.f, m_a1 = 0.f, m_a2 = 0.f;
+    alignas(16) float m_z1[4] = {}; // transposed direct form II state, lanes L R - -
+    alignas(16) float m_z2[4] = {};
+};
+
+// Short room: a four-line feedback delay network with a Hadamard
+// feedback matrix and damping in the loop. The four lines are the four
+// lanes of one SSE register.
+class FdnReverb {
+public:
+    static constexpr std::size_t LINES = 4;
+    static constexpr float DECAY_SECONDS = 0.9f; // RT60
+    static constexpr float DAMPING = 0.3f;       // one-pole low-pass per pass, 0 = bright
+
+    void Prepare(unsigned sampleRate);
+    // 0..1 of the reverb added on top of the dry signal
+    void SetWet(float wet) { m_target.store(wet, std::memory_order_relaxed); }
+    bool Active() const;
+    void Process(float* stereo, std::size_t frames);
+
+private:
+    std::atomic<float> m_target{ 0.f };
+    float m_wet = 0.f; // stream thread: current, gliding towards m_target
+    float m_sampleRate = 44100.f;
+    std::array<std::vector<float>, LINES> m_lines;
+    std::array<std::size_t, LINES> m_cursor{};
+    alignas(16) float m_feedback[LINES] = {}; // per-line gain for DECAY_SECONDS
+    alignas(16) float m_damped[LINES] = {};   // damping filter state
+};
+
+class BusEffects {
+public:
+    // Before the stream starts playing
+    void Prepare(unsigned sampleRate);
+
+    // Hz; BYPASS_CUTOFF or above (or 0) takes the filter out
+    void SetLowPass(float cutoffHz);
+    void SetReverb(float wet);
+
+    // Stream thread
+    bool Active() const { return m_lowPass.Active() || m_reverb.Active(); }
+    void Process(float* stereo, std::size_t frames);
+
+    // Stream thread time per Process call, smoothed; 0 while bypassed
+    float LowPassMicroseconds() const { return m_lowPassMicros.load(std::memory_order_relaxed); }
+    float ReverbMicroseconds() const { return m_reverbMicros.load(std::memory_order_relaxed); }
+
+private:
+    StereoLowPass m_lowPass;
+    FdnReverb m_reverb;
+    std::atomic<float> m_lowPassMicros{ 0.f };
+    std::atomic<float> m_reverbMicros{ 0.f };
+};
@@ -0,0 +1,129 @@
+#include "ClipLibrary.h"
+#include "ResourceCache.h"
+#include "TextureBaker.h"
+#include <iostream>
+#include <unordered_set>
+
+static std::string timingKey(float frameTimeSeconds, bool loop)
+{
+    return std::to_string(frameTimeSeconds) + (loop ? "|loop" : "|once");
+}
+
+ClipLibrary& ClipLibrary::Shared()
+{
+    static ClipLibrary library;
+    return library;
+}
+
+ClipRef ClipLibrary::cached(const std::string& key) const
+{
+    auto it = m_clips.find(key);
+    return it == m_clips.end() ? nullptr : it->second;
+}
+
+ClipRef ClipLibrary::store(const std::string& key, std::shared_ptr<AnimationClip> clip)
+{
+    ClipRef ref = std::move(clip);
+    m_clips[key] = ref;
+    return ref;
+}
+
+ClipRef ClipLibrary::Load(const std::vector<std::string>& framePaths, float frameTimeSeconds, bool loop, float bakeScale)
+{
+    std::string key = timingKey(frameTimeSeconds, loop);
+    if (bakeScale != 1.f) key += "|bake" + std::to_string(bakeScale);
+    for (const auto& path : framePaths) {
+        key += '|';
+        key += ResourceCache::Normalize(path);
+    }
+    if (ClipRef hit = cached(key)) return hit;
+
+    // Decoded images come from the resource cache, so a frame that is also
+    // used as a plain texture elsewhere is only decoded once
+    std::vector<std::shared_ptr<const sf::Image>> handles(framePaths.size());
+    std::vector<const sf::Image*> images(framePaths.size());
+    for (std::size_t i = 0; i < framePaths.size(); ++i) {
+        handles[i] = ResourceCache::Shared().GetImage(framePaths[i], bakeScale);
+        if (!handles[i]) {
+            // If a frame fails to load, the entire clip is considered failed
+            std::cerr << "Warning: animation frame failed to load: " << framePaths[i] << "\n";
+            return nullptr;
+        }
+        images[i] = handles[i].get();
+    }
+
+    auto clip = std::make_shared<AnimationClip>();
+    clip->frameTimeSeconds = frameTimeSeconds;
+    clip->loop = loop;
+    const bool mipmap = bakeScale != 1.f && TextureBaker::Shared().Mipmaps();
+    if (!SpriteSheet::PackImages(images, clip->pages, clip->frames, mipmap)) return nullptr;
+    return store(key, std::move(clip));
+}
+
+ClipRef ClipLibrary::LoadGrid(const std::string& sheetPath, const sf::Vector2i& frameSize,
+    int firstFrame, int frameCount, float frameTimeSeconds, bool loop)
+{
+    const std::string key = timingKey(frameTimeSeconds, loop) + "|grid|" + ResourceCache::Normalize(sheetPath) + "|" +
+        std::to_string(frameSize.x) + "x" + std::to_string(frameSize.y) + "|" +
+        std::to_string(firstFrame) + "+" + std::to_string(frameCount);
+    if (ClipRef hit = cached(key)) return hit;
+
+    auto sheet = ResourceCache::Shared().GetTexture(sheetPath, /*smooth=*/true);
+    if (!sheet) return nullptr;
+
+    auto clip = std::make_shared<AnimationClip>();
+    clip->frameTimeSeconds = frameTimeSeconds;
+    clip->loop = loop;
+    if (!SpriteSheet::GridFrames(sheet->getSize(), frameSize, firstFrame, frameCount, clip->frames)) return nullptr;
+    clip->pages.push_back(std::move(sheet));
+    return store(key, std::move(clip));
+}
+
+ClipRef ClipLibrary::LoadFromJson(const std::string& jsonPath, const std::string& prefix, float frameTimeSeconds, bool loop)
+{
+    const std::string key = timingKey(frameTimeSeconds, loop) + "|json|" + ResourceCache::Normalize(jsonPath) + "|" + prefix;
+    if (ClipRef hit = cached(key)) return hit;
+
+    std::string imagePath;
+    auto clip = std::make_shared<AnimationClip>();
+    if (!SpriteSheet::ParseJson(jsonPath, prefix, imagePath, clip->frames)) return nullptr;
+
+    auto sheet = ResourceCache::Shared().GetTexture(imagePath, /*smooth=*/true);
+    if (!sheet) return nullptr;
+
+    const sf::IntRect bounds(0, 0, static_cast<int>(sheet->getSize().x), static_cast<int>(sheet->getSize().y));
+    for (const auto& f : clip->frames) {
+        if (f.rect.left < 0 || f.rect.top < 0 ||
+            f.rect.left + f.rect.width > bounds.width || f.rect.top + f.rect.height > bounds.height) {
+            std::cerr << "Warning: frame rectangle outside sheet " << imagePath << "\n";
+            return nullptr;
+        }
+    }
+
+    clip->frameTimeSeconds = frameTimeSeconds;
+    clip->loop = loop;
+    clip->pages.push_back(std::move(sheet));
+    return store(key, std::move(clip));
+}
+
+void ClipLibrary::Trim()
+{
+    for (auto it = m_clips.begin(); it != m_clips.end(); ) {
+        if (it->second.use_count() == 1) it = m_clips.erase(it);
+        else ++it;
+    }
+}
+
+std::size_t ClipLibrary::TextureBytes() const
+{
+    // Pages can be shared between clips; count each once
+    std::unordered_set<const sf::Texture*> seen;
+    std::size_t bytes = 0;
+    for (const auto& entry : m_clips) {
+        for (const auto& page : entry.second->pages) {
+            if (!seen.insert(page.get()).second) continue;
+            bytes += static_cast<std::size_t>(page->getSize().x) * page->getSize().y * 4;
+        }
+    }
+    return bytes;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "SpriteSheet.h"
+
+// Frames and timing of one animation clip. Immutable once loaded and
+// shared by every Animation that plays it. Frames are rectangles on one
+// or more sheet pages, so stepping through a clip rarely rebinds a texture.
+struct AnimationClip {
+    std::vector<std::shared_ptr<const sf::Texture>> pages;
+    std::vector<AnimationFrame> frames;
+    float frameTimeSeconds = 0.1f;
+    bool loop = true;
+};
+
+using ClipRef = std::shared_ptr<const AnimationClip>;
+
+// Process-wide cache of animation clips keyed by their source and timing.
+// Loading the same frames twice returns the clip that is already resident.
+// Source images and sheets come from ResourceCache.
+class ClipLibrary {
+public:
+    static ClipLibrary& Shared();
+
+    // One image per frame, packed into sheet pages at load time.
+    // `bakeScale` < 1 packs TextureBaker bakes instead of the full-size
+    // frames (draw the sprite at TextureBaker::SpriteScale to compensate).
+    // Returns nullptr if any frame fails to load.
+    ClipRef Load(const std::vector<std::string>& framePaths, float frameTimeSeconds, bool loop, float bakeScale = 1.f);
+
+    // Uniform grid on a sheet image
+    ClipRef LoadGrid(const std::string& sheetPath, const sf::Vector2i& frameSize,
+        int firstFrame, int frameCount, float frameTimeSeconds, bool loop);
+
+    // Frames named `prefix*` in a TexturePacker-style JSON descriptor
+    ClipRef LoadFromJson(const std::string& jsonPath, const std::string& prefix, float frameTimeSeconds, bool loop);
+
+    // Release clips no Animation references any more
+    void Trim();
+
+    std::size_t ClipCount() const { return m_clips.size(); }
+    std::size_t TextureBytes() const; // RGBA8 estimate of resident frames
+
+private:
+    ClipRef cached(const std::string& key) const;
+    ClipRef store(const std::string& key, std::shared_ptr<AnimationClip> clip);
+
+private:
+    std::unordered_map<std::string, ClipRef> m_clips;
+};
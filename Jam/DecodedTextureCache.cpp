@@ -0,0 +1,207 @@
+#include "DecodedTextureCache.h"
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <cstdio>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    constexpr char MAGIC[4] = { 'J', 'T', 'E', 'X' };
+    constexpr std::uint32_t VERSION = 2;
+    constexpr std::uint32_t FLAG_PREMULTIPLIED = 1;
+    constexpr std::size_t PIXEL_OFFSET = 64; // pixels start on a cache line
+
+    struct TexHeader {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t flags;
+        float scale;                // TextureBaker bake, 1 for full size
+        std::uint64_t sourceSize;
+        std::int64_t sourceMtime;   // PackBlob::stamp for sources inside the pack
+        std::uint64_t sourceHash;
+    };
+    static_assert(sizeof(TexHeader) <= PIXEL_OFFSET, "header must fit before the pixels");
+
+    struct SourceInfo {
+        bool ok = false;
+        std::uint64_t size = 0;
+        std::int64_t mtime = 0;
+    };
+
+    SourceInfo describeSource(const std::string& path, const PackBlob& packed)
+    {
+        SourceInfo info;
+        if (packed) {
+            info.ok = true;
+            info.size = packed.size;
+            info.mtime = packed.stamp;
+            return info;
+        }
+        std::error_code ec;
+        const auto size = fs::file_size(path, ec);
+        if (ec) return info;
+        const auto mtime = fs::last_write_time(path, ec);
+        if (ec) return info;
+        info.ok = true;
+        info.size = static_cast<std::uint64_t>(size);
+        info.mtime = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+        return info;
+    }
+
+    bool hashSource(const std::string& path, const PackBlob& packed, std::uint64_t& hash)
+    {
+        if (packed) {
+            hash = AssetPackFormat::HashBytes(packed.data, packed.size);
+            return true;
+        }
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return false;
+        std::vector<char> chunk(1 << 16);
+        hash = AssetPackFormat::HASH_SEED;
+        while (in) {
+            in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            hash = AssetPackFormat::HashBytes(chunk.data(), static_cast<std::size_t>(in.gcount()), hash);
+        }
+        return true;
+    }
+}
+
+DecodedTextureCache& DecodedTextureCache::Shared()
+{
+    static DecodedTextureCache cache;
+    return cache;
+}
+
+void DecodedTextureCache::Premultiply(sf::Image& image)
+{
+    const sf::Vector2u size = image.getSize();
+    const std::size_t count = static_cast<std::size_t>(size.x) * size.y * 4;
+    if (count == 0) return;
+
+    std::vector<sf::Uint8> pixels(image.getPixelsPtr(), image.getPixelsPtr() + count);
+    for (std::size_t i = 0; i < count; i += 4) {
+        const unsigned a = pixels[i + 3];
+        pixels[i + 0] = static_cast<sf::Uint8>((pixels[i + 0] * a + 127) / 255);
+        pixels[i + 1] = static_cast<sf::Uint8>((pixels[i + 1] * a + 127) / 255);
+        pixels[i + 2] = static_cast<sf::Uint8>((pixels[i + 2] * a + 127) / 255);
+    }
+    image.create(size.x, size.y, pixels.data());
+}
+
+std::string DecodedTextureCache::entryPath(const std::string& path, float scale) const
+{
+    std::string key = AssetPackFormat::NormalizePath(path);
+    if (scale != 1.f) key += "@" + std::to_string(scale);
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.tex", static_cast<unsigned long long>(AssetPackFormat::HashPath(key)));
+    return (fs::path(m_directory) / name).string();
+}
+
+std::unique_ptr<DecodedBlob> DecodedTextureCache::Open(const std::string& path, const PackBlob& packed, float scale) const
+{
+    if (!m_enabled) return nullptr;
+
+    const SourceInfo source = describeSource(path, packed);
+    if (!source.ok) return nullptr;
+
+    const std::string entry = entryPath(path, scale);
+    TexHeader header;
+    {
+        std::ifstream in(entry, std::ios::binary);
+        if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            ++m_misses;
+            return nullptr;
+        }
+    }
+
+    const std::uint32_t wantFlags = m_premultiplied ? FLAG_PREMULTIPLIED : 0;
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.flags != wantFlags || header.scale != scale || header.width == 0 || header.height == 0 ||
+        header.sourceSize != source.size) {
+        ++m_stale;
+        return nullptr;
+    }
+
+    if (source.mtime == 0 || header.sourceMtime != source.mtime) {
+        // Touched source or rebuilt pack: only the content decides
+        std::uint64_t hash = 0;
+        if (!hashSource(path, packed, hash) || hash != header.sourceHash) {
+            ++m_stale;
+            return nullptr;
+        }
+        if (source.mtime != 0) {
+            // Same content, new timestamp or stamp: record it so the next start skips the hash
+            std::fstream out(entry, std::ios::binary | std::ios::in | std::ios::out);
+            out.seekp(offsetof(TexHeader, sourceMtime));
+            out.write(reinterpret_cast<const char*>(&source.mtime), sizeof(source.mtime));
+        }
+    }
+
+    auto blob = std::make_unique<DecodedBlob>();
+    const std::size_t pixelBytes = static_cast<std::size_t>(header.width) * header.height * 4;
+    if (!blob->file.Open(entry) || blob->file.Size() != PIXEL_OFFSET + pixelBytes) {
+        ++m_stale;
+        return nullptr;
+    }
+    blob->width = header.width;
+    blob->height = header.height;
+    blob->pixels = blob->file.Data() + PIXEL_OFFSET;
+    ++m_hits;
+    return blob;
+}
+
+bool DecodedTextureCache::Store(const std::string& path, const PackBlob& packed, const sf::Image& image, float scale) const
+{
+    if (!m_enabled) return false;
+
+    const sf::Vector2u size = image.getSize();
+    const SourceInfo source = describeSource(path, packed);
+    TexHeader header{};
+    if (size.x == 0 || size.y == 0 || !source.ok || !hashSource(path, packed, header.sourceHash))
+        return false;
+
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.width = size.x;
+    header.height = size.y;
+    header.flags = m_premultiplied ? FLAG_PREMULTIPLIED : 0;
+    header.scale = scale;
+    header.sourceSize = source.size;
+    header.sourceMtime = source.mtime;
+
+    std::error_code ec;
+    fs::create_directories(m_directory, ec);
+
+    // Write beside the entry and rename, so a reader never maps half a file
+    const std::string entry = entryPath(path, scale);
+    const std::string temp = entry + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        char prefix[PIXEL_OFFSET] = {};
+        std::memcpy(prefix, &header, sizeof(header));
+        out.write(prefix, sizeof(prefix));
+        out.write(reinterpret_cast<const char*>(image.getPixelsPtr()),
+            static_cast<std::streamsize>(static_cast<std::size_t>(size.x) * size.y * 4));
+        if (!out.flush()) {
+            out.close();
+            fs::remove(temp, ec);
+            return false;
+        }
+    }
+    fs::rename(temp, entry, ec);
+    if (ec) {
+        // Typically the old entry is still mapped on Windows; keep it, it is just stale
+        fs::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "AssetPack.h"
+
+// Pixels of one cached texture, mapped straight from its .tex file
+struct DecodedBlob {
+    MappedFile file;
+    unsigned width = 0;
+    unsigned height = 0;
+    const std::uint8_t* pixels = nullptr; // RGBA8, width * height * 4 bytes
+};
+
+// On-disk cache of decoded RGBA pixels, so PNG/JPG decompression only
+// happens the first time an image is seen (or after it changes). Each
+// entry records the source's size, modification time and content hash:
+// matching size + mtime is trusted as is, otherwise the source is hashed
+// and the entry is reused if the content is unchanged. Sources inside the
+// asset pack use PackBlob::stamp (the pack's mtime and the entry's offset)
+// in place of an mtime, so they are only hashed after the pack is rebuilt.
+//
+// Open and Store may be called from loader threads; configure the cache
+// before loading starts.
+class DecodedTextureCache {
+public:
+    static DecodedTextureCache& Shared();
+
+    void SetDirectory(const std::string& dir) { m_directory = dir; }
+    void SetEnabled(bool enabled) { m_enabled = enabled; }
+    bool IsEnabled() const { return m_enabled; }
+
+    // Store colour multiplied by alpha. Off by default: the renderer blends
+    // straight alpha, so premultiplied textures need a premultiplied blend mode
+    void SetPremultipliedAlpha(bool premultiplied) { m_premultiplied = premultiplied; }
+    bool PremultipliedAlpha() const { return m_premultiplied; }
+    static void Premultiply(sf::Image& image);
+
+    // Mapped pixels if the entry exists and still matches its source, else nullptr.
+    // `packed` is the source blob when it comes from the asset pack; `scale`
+    // selects a TextureBaker bake of the source (1 = full size).
+    std::unique_ptr<DecodedBlob> Open(const std::string& path, const PackBlob& packed, float scale = 1.f) const;
+
+    // Write (or replace) the entry for a freshly decoded source
+    bool Store(const std::string& path, const PackBlob& packed, const sf::Image& image, float scale = 1.f) const;
+
+    std::uint64_t Hits() const { return m_hits; }
+    std::uint64_t Misses() const { return m_misses; }
+    std::uint64_t Stale() const { return m_stale; }
+
+private:
+    std::string entryPath(const std::string& path, float scale) const;
+
+private:
+    std::string m_directory = "texcache";
+    bool m_enabled = true;
+    bool m_premultiplied = false;
+
+    mutable std::atomic<std::uint64_t> m_hits{ 0 };
+    mutable std::atomic<std::uint64_t> m_misses{ 0 };
+    mutable std::atomic<std::uint64_t> m_stale{ 0 };
+};
@@ -0,0 +1,105 @@
+#include "DynamicResolution.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    constexpr float SCALE_STEP_DOWN = 0.10f;
+    constexpr float SCALE_STEP_UP = 0.05f;
+    constexpr float OVER_BUDGET = 1.15f;    // drop resolution above 115% of target
+    constexpr float UNDER_BUDGET = 1.05f;   // considered "holding" below 105% of target
+    constexpr float HEADROOM_DELAY = 1.5f;  // seconds of holding before probing upward
+    constexpr float CHANGE_COOLDOWN = 0.5f;
+    constexpr float AVG_WEIGHT = 0.1f;
+}
+
+bool DynamicResolution::Init(const sf::Vector2u& nativeSize)
+{
+    m_nativeSize = nativeSize;
+    m_ready = m_target.create(nativeSize.x, nativeSize.y);
+    if (!m_ready) {
+        std::cerr << "Warning: dynamic resolution disabled (render texture unavailable)\n";
+        return false;
+    }
+    m_target.setSmooth(true); // bilinear upscale
+    m_present.setTexture(m_target.getTexture(), true);
+    return true;
+}
+
+void DynamicResolution::SetEnabled(bool enabled)
+{
+    m_enabled = enabled;
+    m_scale = m_maxScale;
+    m_headroomTime = 0.f;
+    m_cooldown = 0.f;
+}
+
+void DynamicResolution::SetScaleRange(float minScale, float maxScale)
+{
+    m_minScale = std::clamp(minScale, 0.1f, 1.f);
+    m_maxScale = std::clamp(maxScale, m_minScale, 1.f);
+    m_scale = std::clamp(m_scale, m_minScale, m_maxScale);
+}
+
+void DynamicResolution::Update(float frameSeconds)
+{
+    if (!m_ready || !m_enabled) return;
+
+    // Ignore hitches such as window focus changes or loading spikes
+    frameSeconds = std::min(frameSeconds, m_targetFrameTime * 4.f);
+    m_avgFrameTime += (frameSeconds - m_avgFrameTime) * AVG_WEIGHT;
+
+    if (m_cooldown > 0.f) {
+        m_cooldown -= frameSeconds;
+        return;
+    }
+
+    if (m_avgFrameTime > m_targetFrameTime * OVER_BUDGET) {
+        m_scale = std::max(m_minScale, m_scale - SCALE_STEP_DOWN);
+        m_headroomTime = 0.f;
+        m_cooldown = CHANGE_COOLDOWN;
+    }
+    else if (m_avgFrameTime < m_targetFrameTime * UNDER_BUDGET) {
+        // Frame limiter hides real headroom, so probe upward after holding for a while
+        m_headroomTime += frameSeconds;
+        if (m_headroomTime >= HEADROOM_DELAY && m_scale < m_maxScale) {
+            m_scale = std::min(m_maxScale, m_scale + SCALE_STEP_UP);
+            m_headroomTime = 0.f;
+            m_cooldown = CHANGE_COOLDOWN;
+        }
+    }
+    else {
+        m_headroomTime = 0.f;
+    }
+}
+
+sf::Vector2u DynamicResolution::scaledSize() const
+{
+    unsigned w = static_cast<unsigned>(std::lround(m_nativeSize.x * m_scale));
+    unsigned h = static_cast<unsigned>(std::lround(m_nativeSize.y * m_scale));
+    return { std::max(1u, w), std::max(1u, h) };
+}
+
+sf::View DynamicResolution::ScaledView(const sf::View& camera) const
+{
+    // Viewport snapped to whole pixels so the upscale samples exactly what was drawn
+    const sf::Vector2u sz = scaledSize();
+    sf::View v = camera;
+    v.setViewport(sf::FloatRect(0.f, 0.f,
+        static_cast<float>(sz.x) / static_cast<float>(m_nativeSize.x),
+        static_cast<float>(sz.y) / static_cast<float>(m_nativeSize.y)));
+    return v;
+}
+
+void DynamicResolution::Present(Renderer& renderer)
+{
+    m_target.display();
+
+    const sf::Vector2u sz = scaledSize();
+    const sf::Vector2u out = renderer.GetSize();
+    m_present.setTextureRect(sf::IntRect(0, 0, static_cast<int>(sz.x), static_cast<int>(sz.y)));
+    m_present.setPosition(0.f, 0.f);
+    m_present.setScale(static_cast<float>(out.x) / static_cast<float>(sz.x),
+        static_cast<float>(out.y) / static_cast<float>(sz.y));
+    renderer.Draw(m_present);
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "Renderer.h"
+
+// Renders the world pass into an off-screen texture whose effective size
+// follows measured frame time, then upscales it to the window.
+// The texture is allocated once at native size; lower scales only render
+// into its top-left sub-rectangle, so changing scale never reallocates.
+class DynamicResolution {
+public:
+    DynamicResolution() = default;
+
+    // Allocate the off-screen target. Returns false if render textures are unsupported.
+    bool Init(const sf::Vector2u& nativeSize);
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const { return m_enabled; }
+
+    void SetScaleRange(float minScale, float maxScale);
+    void SetTargetFrameTime(float seconds) { m_targetFrameTime = seconds; }
+
+    // Feed the last frame's duration; adjusts the scale with hysteresis.
+    void Update(float frameSeconds);
+
+    float Scale() const { return m_scale; }
+
+    // True when the world should be drawn off-screen (enabled and below native scale)
+    bool IsActive() const { return m_ready && m_enabled && m_scale < 0.999f; }
+
+    sf::RenderTexture& Target() { return m_target; }
+
+    // Camera view mapped onto the scaled sub-rectangle of the off-screen target
+    sf::View ScaledView(const sf::View& camera) const;
+
+    // Finish the off-screen pass and draw it stretched over the whole window.
+    // Expects the renderer to already target the window with its default view.
+    void Present(Renderer& renderer);
+
+private:
+    sf::Vector2u scaledSize() const;
+
+private:
+    sf::RenderTexture m_target;
+    sf::Sprite m_present;
+    sf::Vector2u m_nativeSize{ 0, 0 };
+    bool m_ready = false;
+    bool m_enabled = true;
+
+    float m_minScale = 0.5f;
+    float m_maxScale = 1.0f;
+    float m_scale = 1.0f;
+
+    float m_targetFrameTime = 1.f / 60.f;
+    float m_avgFrameTime = 1.f / 60.f; // exponential moving average
+    float m_cooldown = 0.f;            // seconds until the next change is allowed
+    float m_headroomTime = 0.f;        // how long we've been comfortably under budget
+};
@@ -1,6 +1,7 @@
 #include "Game.h"
 #include "World.h"
 #include "OptionsUI.h"
+#include "TextureBaker.h"
 
 #include <iostream>
 #include <cstdlib>
@@ -12,7 +13,7 @@ using namespace sf;
 
 constexpr float PPM = 30.f;
 constexpr float INV_PPM = 1.f / PPM;
-std::unordered_map<std::string, std::shared_ptr<AudioEmitter>> m_playerEmitters;
+std::unordered_map<std::string, EmitterHandle> m_playerEmitters;
 
 static float randomFloat(float min, float max) {
 	return min + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (max - min)));
@@ -42,6 +43,7 @@ Game::Game()
 	: m_window(VideoMode::getDesktopMode(),
 		"SFML + Box2D + AudioManager + Persona Demo",
 		Style::Fullscreen),
+	m_renderer(m_window),
 	m_camera(FloatRect(0, 0,
 		1920,
 		1080)),
@@ -66,13 +68,180 @@ Game::Game()
 	m_lastAppliedAudioState(PlayerAudioState::Neutral)
 {
 	srand(static_cast<unsigned>(time(nullptr)));
+
+	// Built by Tools/AssetPacker; without it everything loads from the loose files
+	ResourceCache::Shared().MountPack("Assets.pak");
+
 	m_window.setFramerateLimit(60);
+	m_dynamicRes.Init(m_window.getSize());
+	m_dynamicRes.SetScaleRange(0.5f, 1.f);
+	m_dynamicRes.SetTargetFrameTime(1.f / 60.f);
 	m_world.SetContactListener(&m_contactListener);
-	m_worldView = std::make_unique<World>(m_world);
 
-	// Store World (creates obstacles and holds category bits)
-	m_worldView = std::make_unique<World>(m_world);
+	// Sprites drawn below 1:1 are baked to their on-screen size while loading
+	TextureBaker::Shared().SetTarget(m_camera.getSize(), m_window.getSize());
+
+	// Decode gameplay assets in the background; the menu comes up right away
+	m_loader = std::make_unique<AsyncLoader>();
+	queueGameplayAssets();
+
+	nextPsychoSwitch = randomFloat(6.f, 8.f);
+	psychoClock.restart();
+
+	nextSplitCheck = randomFloat(1.f, 3.f);
+	splitClock.restart();
+
+	nextInputLockCheck = randomFloat(3.f, 6.f);
+	inputLockClock.restart();
+
+	m_font = ResourceCache::Shared().GetFont("assets/Font/Myriad Arabic Regular.ttf");
+	if (!m_font) {
+		std::cerr << "Warning: font not loaded (assets/arial.ttf)\n";
+		m_font = std::make_shared<const sf::Font>();
+	}
+	m_debugText.SetFont(*m_font);
+	m_debugText.SetCharacterSize(16);
+	m_debugText.SetFillColor(Color::White);
+	m_debugText.SetPosition({ 10.f, 10.f });
+
+	m_statsText.setFont(*m_font);
+	m_statsText.setCharacterSize(16);
+	m_statsText.setFillColor(Color::Yellow);
+	m_statsText.setPosition((float)m_window.getSize().x - 640.f, 10.f);
+
+	m_mainMenu = std::make_unique<MainMenu>(m_window.getSize());
+	m_mainMenu->SetFont(m_font.get());
+	m_mainMenu->BuildLayout();
+
+	// Pause UI init
+	m_pauseOverlay.setSize(Vector2f((float)m_window.getSize().x, (float)m_window.getSize().y));
+	m_pauseOverlay.setFillColor(Color(0, 0, 0, 160));
+
+	// Create simple resume/back buttons using MenuButton style
+	m_pauseResumeButton = std::make_unique<MenuButton>(*m_font, "Resume", Vector2f((float)m_window.getSize().x * 0.5f, (float)m_window.getSize().y * 0.45f), Vector2f(360.f, 72.f));
+	m_pauseBackButton = std::make_unique<MenuButton>(*m_font, "Back to Menu", Vector2f((float)m_window.getSize().x * 0.5f, (float)m_window.getSize().y * 0.55f), Vector2f(360.f, 72.f));
+
+	m_pauseResumeButton->SetEnabled(true);
+	m_pauseBackButton->SetEnabled(true);
+
+	m_pauseResumeButton->SetPersistentAccent(true);
+
+	// initialize game-over text
+	m_gameOver = false;
+	m_gameOverDelay = 3.f;
+	m_gameOverText.setFont(*m_font);
+	m_gameOverText.setCharacterSize(72);           // big text
+	m_gameOverText.setStyle(sf::Text::Bold);
+	m_gameOverText.setFillColor(sf::Color::Red);
+	m_gameOverText.setOutlineThickness(2.f);
+	m_gameOverText.setOutlineColor(sf::Color::Black);
+	m_gameOverText.setString(""); // initially empty
+
+	m_countdownText.SetFont(*m_font);
+	m_countdownText.SetCharacterSize(42);
+	m_countdownText.SetFillColor(sf::Color::White);
+	m_countdownText.SetStyle(sf::Text::Bold);
+	m_countdownText.SetCentered(true);
+
+
+	// Wire button callbacks
+	m_pauseResumeButton->RefreshLayout();
+	m_pauseBackButton->RefreshLayout();
+
+	m_mainMenu->OnPlay = [this]() {
+		if (!m_gameplayReady) return;
+		ResetGameplay(true);
+
+		m_state = GameState::PLAYING;
+		m_audio.StartMusic();
+
+		// start looping ambient emitters only if buffers exist
+		m_audio.Play(m_dialogueEmitter);
+		m_audio.Play(m_effectEmitter);
+		};
+	m_mainMenu->OnExit = [this]() {
+		m_window.close();
+		};
+	m_mainMenu->OnOptions = [this]() {
+		OptionsUI::Show(m_audio, *m_font, m_mainMenu.get(), m_renderer);
+		};
+
+
+	m_frameClock.restart();
+}
+
+Game::~Game() {}
+
+// Sound effects the gameplay emitters play (the bus pass sound is m_busAudioPath)
+static const char* const kGameplaySounds[] = {
+	"assets/Audio/player_reply.wav",
+	"assets/Audio/grocery_line1.wav",
+	"assets/Audio/grocery_line2.wav",
+	"assets/Audio/grocery_collision.wav",
+	"assets/Audio/dialogue.wav",
+	"assets/Audio/effect.wav",
+	"assets/Audio/refuse.wav",
+};
+
+void Game::queueGameplayAssets()
+{
+	World::QueueAssets(*m_loader);
+	Player::QueueAssets(*m_loader);
+	// Sounds stay encoded in the bank; emitters decode them as they come within range
+	SoundBank& sounds = SoundBank::Shared();
+	sounds.SetBudget(SOUND_BANK_BUDGET);
+	for (const char* sound : kGameplaySounds)
+		sounds.Add(sound);
+	sounds.Add(m_busAudioPath);
+}
 
+void Game::pumpLoader()
+{
+	// Packing a player clip into sheet pages and building the world are each
+	// too big for the upload budget, so once the loader is done they get a
+	// frame of their own: one clip per frame, then the world, then the rest
+	constexpr std::size_t clipSteps = static_cast<std::size_t>(PlayerClip::Count);
+	constexpr std::size_t buildSteps = clipSteps + 2;
+	const auto reportProgress = [this] {
+		m_mainMenu->SetLoadingProgress(static_cast<float>(m_loader->Completed() + m_buildStep) /
+			static_cast<float>(m_loader->Total() + buildSteps));
+	};
+
+	// Uploads get a slice of the frame so the menu keeps animating
+	if (!m_loader->Pump(sf::milliseconds(4))) {
+		reportProgress();
+		return;
+	}
+
+	if (m_buildStep == 0 && m_loader->Failed() > 0)
+		std::cerr << "Warning: " << m_loader->Failed() << " assets failed to load in the background\n";
+	if (m_buildStep < clipSteps) {
+		const PlayerClip clip = static_cast<PlayerClip>(m_buildStep++);
+		if (!Player::PrepareClip(clip))
+			std::cerr << "Warning: failed to pack player clip " << static_cast<int>(clip) << "\n";
+		reportProgress();
+		return;
+	}
+	if (m_buildStep == clipSteps) {
+		// Store World (creates obstacles and holds category bits)
+		m_worldView = std::make_unique<World>(m_world);
+		++m_buildStep;
+		reportProgress();
+		return;
+	}
+	m_loader.reset();
+
+	// Everything is resident now, so construction only hits the cache
+	buildGameplay();
+	m_gameplayReady = true;
+	m_mainMenu->SetLoadingProgress(1.f);
+
+	// Decoded images were only needed to build textures and clips
+	ResourceCache::Shared().Trim();
+}
+
+void Game::buildGameplay()
+{
 	// Ground (Box2D)
 	b2BodyDef groundDef;
 	groundDef.type = b2_staticBody;
@@ -98,90 +267,94 @@ Game::Game()
 	m_fxMark.setFillColor(Color::Cyan);
 	m_fxMark.setOrigin(8.f, 8.f);
 
-	m_dialogueEmitter = std::make_shared<AudioEmitter>();
-	m_dialogueEmitter->id = "dialogue1";
-	m_dialogueEmitter->category = AudioCategory::Dialogue;
-	m_dialogueEmitter->position = b2Vec2((640 - 100) * INV_PPM, (680 - 50) * INV_PPM);
-	m_dialogueEmitter->minDistance = 0.5f;
-	m_dialogueEmitter->maxDistance = 20.f;
-	m_dialogueEmitter->baseVolume = 1.f;
+	auto dialogueEmitter = std::make_unique<AudioEmitter>();
+	dialogueEmitter->id = "dialogue1";
+	dialogueEmitter->category = AudioCategory::Dialogue;
+	dialogueEmitter->position = b2Vec2((640 - 100) * INV_PPM, (680 - 50) * INV_PPM);
+	dialogueEmitter->minDistance = 0.5f;
+	dialogueEmitter->maxDistance = 20.f;
+	dialogueEmitter->baseVolume = 1.f;
 
-	m_effectEmitter = std::make_shared<AudioEmitter>();
-	m_effectEmitter->id = "effect1";
-	m_effectEmitter->category = AudioCategory::Effects;
-	m_effectEmitter->position = b2Vec2((640 + 100) * INV_PPM, (680 - 50) * INV_PPM);
-	m_effectEmitter->minDistance = 0.5f;
-	m_effectEmitter->maxDistance = 20.f;
-	m_effectEmitter->baseVolume = 1.f;
+	auto effectEmitter = std::make_unique<AudioEmitter>();
+	effectEmitter->id = "effect1";
+	effectEmitter->category = AudioCategory::Effects;
+	effectEmitter->position = b2Vec2((640 + 100) * INV_PPM, (680 - 50) * INV_PPM);
+	effectEmitter->minDistance = 0.5f;
+	effectEmitter->maxDistance = 20.f;
+	effectEmitter->baseVolume = 1.f;
 
 
 	// player reply emitter (just like refuse)
-	m_playerReply = std::make_shared<AudioEmitter>();
-	m_playerReply->id = "playerReply";
-	m_playerReply->category = AudioCategory::Dialogue;
-	m_playerReply->minDistance = 0.5f;
-	m_playerReply->maxDistance = 20.f;
-	m_playerReply->baseVolume = 1.f;
-	m_playerReply->position = b2Vec2(0.f, 0.f); // optional: track player position if you want
-	if (!m_playerReply->loadBuffer("assets/Audio/player_reply.wav")) {
+	auto playerReply = std::make_unique<AudioEmitter>();
+	playerReply->id = "playerReply";
+	playerReply->category = AudioCategory::Dialogue;
+	playerReply->minDistance = 0.5f;
+	playerReply->maxDistance = 20.f;
+	playerReply->baseVolume = 1.f;
+	if (!playerReply->loadBuffer("assets/Audio/player_reply.wav")) {
 		std::cerr << "Warning: player reply audio not loaded\n";
 	}
-	m_playerReply->sound.setLoop(false);
-	m_audio.RegisterEmitter(m_playerReply);
+	playerReply->setLoop(false);
+	playerReply->priority = 2;
+	m_playerReply = m_audio.AddEmitter(std::move(playerReply));
 
 	// find the grocery obstacle by filename substring (change "grocery" to match your filename)
 	m_groceryObstacleIndex = m_worldView->findObstacleByTextureSubstring("grocery");
 
 	if (m_groceryObstacleIndex >= 0)
 	{
-		auto makeGroceryEmitter = [&](const std::string& id, const std::string& filePath)->std::shared_ptr<AudioEmitter> {
-			auto e = std::make_shared<AudioEmitter>();
+		auto makeGroceryEmitter = [&](const std::string& id, const std::string& filePath, int priority)->EmitterHandle {
+			auto e = std::make_unique<AudioEmitter>();
 			e->id = id;
 			e->category = AudioCategory::Dialogue; // grocery is dialogue-like
 			e->minDistance = 0.5f;
 			e->maxDistance = 50.f;
 			e->baseVolume = 1.f;
-			// initial position (will be updated each frame in update())
-			b2Vec2 p = m_worldView->getObstacleBodyPosition(m_groceryObstacleIndex);
-			e->position = p;
+			e->priority = priority;
+			e->position = m_worldView->getObstacleBodyPosition(m_groceryObstacleIndex);
 			if (!e->loadBuffer(filePath)) {
 				std::cerr << "Warning: grocery audio not loaded: " << filePath << "\n";
 			}
-			e->sound.setLoop(false);
-			m_audio.RegisterEmitter(e);
-			return e;
+			e->setLoop(false);
+			EmitterHandle h = m_audio.AddEmitter(std::move(e));
+			// follows the obstacle's body from here on
+			m_audio.AttachToBody(h, m_worldView->getObstacleBody(m_groceryObstacleIndex));
+			return h;
 			};
 
 		// filenames  create these WAV/OGG files in your assets folder
-		m_groceryA = makeGroceryEmitter("groceryA", "assets/Audio/grocery_line1.wav");
-		m_groceryB = makeGroceryEmitter("groceryB", "assets/Audio/grocery_line2.wav");
-		m_groceryCollision = makeGroceryEmitter("groceryCollision", "assets/Audio/grocery_collision.wav");
+		m_groceryA = makeGroceryEmitter("groceryA", "assets/Audio/grocery_line1.wav", 0);
+		m_groceryB = makeGroceryEmitter("groceryB", "assets/Audio/grocery_line2.wav", 0);
+		m_groceryCollision = makeGroceryEmitter("groceryCollision", "assets/Audio/grocery_collision.wav", 1); // the player is waiting on this one
 
 		m_groceryClock.restart();
 		m_nextGroceryLineTime = randomFloat(5.f, 10.f);
 	}
 
 	// --- Bus visual + audio setup ---
-	if (!m_busTexture.loadFromFile("Assets/Obstacles/bus.png")) {
+	// Same image as the parked bus prop, so this is a cache hit
+	m_busTexture = ResourceCache::Shared().GetTexture("Assets/Obstacles/bus.png");
+	if (!m_busTexture) {
 		std::cerr << "Warning: bus texture not loaded (Assets/Obstacles/bus.png)\n";
+		m_busTexture = std::make_shared<const sf::Texture>();
 	}
 	m_busSpawnClock.restart();
 	m_busTravelTime = 3.5f;         // enforce 2 seconds travel
 	m_busSpawnInterval = 16.f;     // 30 seconds between spawns
 
 	// Create/register a single bus emitter (reused for each pass).
-	m_busEmitter = std::make_shared<AudioEmitter>();
-	m_busEmitter->id = "bus_pass";
-	m_busEmitter->category = AudioCategory::Dialogue; // or Dialogue depending on your mixer
-	m_busEmitter->minDistance = 0.5f;
-	m_busEmitter->maxDistance = 50.f;
-	m_busEmitter->baseVolume = 1.f;
-	m_busEmitter->position = b2Vec2(0.f, 0.f);
-	if (!m_busEmitter->loadBuffer(m_busAudioPath)) {
+	auto busEmitter = std::make_unique<AudioEmitter>();
+	busEmitter->id = "bus_pass";
+	busEmitter->category = AudioCategory::Dialogue; // or Dialogue depending on your mixer
+	busEmitter->minDistance = 0.5f;
+	busEmitter->maxDistance = 50.f;
+	busEmitter->baseVolume = 1.f;
+	busEmitter->position = b2Vec2(0.f, 0.f);
+	if (!busEmitter->loadBuffer(m_busAudioPath)) {
 		std::cerr << "Warning: bus pass audio not loaded: " << m_busAudioPath << "\n";
 	}
-	m_busEmitter->sound.setLoop(false);
-	m_audio.RegisterEmitter(m_busEmitter);
+	busEmitter->setLoop(false);
+	m_busEmitter = m_audio.AddEmitter(std::move(busEmitter));
 
 
 
@@ -189,15 +362,18 @@ Game::Game()
 	bool ok = m_audio.loadMusic("Assets/Audio/music_neutral.ogg", "Assets/Audio/music_crazy.ogg");
 	if (!ok) std::cerr << "Warning: music not loaded. Replace file paths with your assets.\n";
 
-	if (!m_dialogueEmitter->loadBuffer("assets/Audio/dialogue.wav"))
+	if (!dialogueEmitter->loadBuffer("assets/Audio/dialogue.wav"))
 		std::cerr << "Warning: dialogue.wav not loaded.\n";
-	if (!m_effectEmitter->loadBuffer("assets/Audio/effect.wav"))
+	if (!effectEmitter->loadBuffer("assets/Audio/effect.wav"))
 		std::cerr << "Warning: effect.wav not loaded.\n";
 
-	m_audio.RegisterEmitter(m_dialogueEmitter);
-	m_audio.RegisterEmitter(m_effectEmitter);
-	m_dialogueEmitter->sound.setLoop(true);
-	m_effectEmitter->sound.setLoop(true);
+	dialogueEmitter->setLoop(true);
+	effectEmitter->setLoop(true);
+	// Ambient loops restart rather than stack when triggered again
+	dialogueEmitter->maxInstances = 1;
+	effectEmitter->maxInstances = 1;
+	m_dialogueEmitter = m_audio.AddEmitter(std::move(dialogueEmitter));
+	m_effectEmitter = m_audio.AddEmitter(std::move(effectEmitter));
 
 	m_audio.SetMasterVolume(1.f);
 	m_audio.SetMusicVolume(0.9f);
@@ -207,7 +383,7 @@ Game::Game()
 
 	// --- Player emitters ---
 	auto createPlayerEmitter = [&](const std::string& id, const std::string& filePath) {
-		auto emitter = std::make_shared<AudioEmitter>();
+		auto emitter = std::make_unique<AudioEmitter>();
 		emitter->id = id;
 		emitter->category = AudioCategory::Dialogue; // <-- make it dialogue so dialogue volume affects it
 		emitter->position = m_player->GetBody()->GetPosition();
@@ -218,15 +394,17 @@ Game::Game()
 		if (!emitter->loadBuffer(filePath))
 			std::cerr << "Warning: " << filePath << " not loaded.\n";
 
-		emitter->sound.setLoop(false);
-		m_audio.RegisterEmitter(emitter);
-		m_playerEmitters[id] = emitter;
+		emitter->setLoop(false);
+		emitter->priority = 2; // the player's own lines are never the ones cut
+		EmitterHandle h = m_audio.AddEmitter(std::move(emitter));
+		m_audio.AttachToBody(h, m_player->GetBody());
+		m_playerEmitters[id] = h;
 		};
 
 	createPlayerEmitter("refuse", "assets/Audio/refuse.wav");
 	createPlayerEmitter("player_reply", "assets/Audio/player_reply.wav");
 	auto dbgIt = m_playerEmitters.find("player_reply");
-	if (dbgIt == m_playerEmitters.end() || !dbgIt->second || !dbgIt->second->buffer) {
+	if (dbgIt == m_playerEmitters.end() || !m_audio.IsLoaded(dbgIt->second)) {
 		std::cerr << "DEBUG: player_reply emitter missing or buffer not loaded. Check path & case sensitivity.\n";
 	}
 	else {
@@ -237,79 +415,20 @@ Game::Game()
 	//createPlayerEmitter("attack", "assets/Audio/attack.wav");
 	//// Add more player sounds as needed
 
-	nextPsychoSwitch = randomFloat(6.f, 8.f);
-	psychoClock.restart();
-
-	nextSplitCheck = randomFloat(1.f, 3.f);
-	splitClock.restart();
-
-	nextInputLockCheck = randomFloat(3.f, 6.f);
-	inputLockClock.restart();
-
-	if (!m_font.loadFromFile("assets/Font/Myriad Arabic Regular.ttf")) {
-		std::cerr << "Warning: font not loaded (assets/arial.ttf)\n";
+	m_sewerObstacles.clear();
+	for (const char* cap : { "Closed_sewers_cap", "sewers_cap1" }) {
+		const int index = m_worldView->findObstacleByTextureSubstring(cap);
+		if (index >= 0) m_sewerObstacles.push_back(index);
 	}
-	m_debugText.setFont(m_font);
-	m_debugText.setCharacterSize(16);
-	m_debugText.setFillColor(Color::White);
-	m_debugText.setPosition(10.f, 10.f);
 
-	m_mainMenu = std::make_unique<MainMenu>(m_window.getSize());
-	m_mainMenu->SetFont(&m_font);
-	m_mainMenu->BuildLayout();
+	// One software-mixed stream for every voice, so buses can carry insert effects
+	if (m_busEffects)
+		m_audio.EnableSoftwareMixer(64);
 
-	// Pause UI init
-	m_pauseOverlay.setSize(Vector2f((float)m_window.getSize().x, (float)m_window.getSize().y));
-	m_pauseOverlay.setFillColor(Color(0, 0, 0, 160));
-
-	// Create simple resume/back buttons using MenuButton style
-	m_pauseResumeButton = std::make_unique<MenuButton>(m_font, "Resume", Vector2f((float)m_window.getSize().x * 0.5f, (float)m_window.getSize().y * 0.45f), Vector2f(360.f, 72.f));
-	m_pauseBackButton = std::make_unique<MenuButton>(m_font, "Back to Menu", Vector2f((float)m_window.getSize().x * 0.5f, (float)m_window.getSize().y * 0.55f), Vector2f(360.f, 72.f));
-
-	m_pauseResumeButton->SetEnabled(true);
-	m_pauseBackButton->SetEnabled(true);
-
-	m_pauseResumeButton->SetPersistentAccent(true);
-
-	// initialize game-over text
-	m_gameOver = false;
-	m_gameOverDelay = 3.f;
-	m_gameOverText.setFont(m_font);
-	m_gameOverText.setCharacterSize(72);           // big text
-	m_gameOverText.setStyle(sf::Text::Bold);
-	m_gameOverText.setFillColor(sf::Color::Red);
-	m_gameOverText.setOutlineThickness(2.f);
-	m_gameOverText.setOutlineColor(sf::Color::Black);
-	m_gameOverText.setString(""); // initially empty
-
-
-	// Wire button callbacks
-	m_pauseResumeButton->RefreshLayout();
-	m_pauseBackButton->RefreshLayout();
-
-	m_mainMenu->OnPlay = [this]() {
-		ResetGameplay(true);
-
-		m_state = GameState::PLAYING;
-		m_audio.StartMusic();
-
-		// start looping ambient emitters only if buffers exist
-		if (m_dialogueEmitter && m_dialogueEmitter->buffer) m_dialogueEmitter->sound.play();
-		if (m_effectEmitter && m_effectEmitter->buffer) m_effectEmitter->sound.play();
-		};
-	m_mainMenu->OnExit = [this]() {
-		m_window.close();
-		};
-	m_mainMenu->OnOptions = [this]() {
-		OptionsUI::Show(m_audio, m_font, m_mainMenu.get());
-		};
-
-
-	m_frameClock.restart();
+	// Music and emitters are set up; from here on audio calls are queued for the audio thread
+	m_audio.StartThread();
 }
 
-Game::~Game() {}
-
 int Game::Run()
 {
 	while (m_window.isOpen() && m_running) {
@@ -320,6 +439,7 @@ int Game::Run()
 		if (m_state == GameState::PLAYING && !m_paused) {
 			if (m_worldView) m_worldView->update(dt, m_camera.getCenter());
 			update(dt);
+			m_dynamicRes.Update(dt);
 		}
 		else if (m_state == GameState::PLAYING && m_paused) {
 			// paused -> only process pause UI updates (tween buttons)
@@ -327,6 +447,7 @@ int Game::Run()
 			m_pauseBackButton->Update(dt, Vector2f((float)Mouse::getPosition(m_window).x, (float)Mouse::getPosition(m_window).y));
 		}
 		else {
+			if (!m_gameplayReady) pumpLoader();
 			m_audio.StopMusic();
 			m_mainMenu->Update(dt, m_window);
 		}
@@ -348,6 +469,22 @@ void Game::processEvents()
 		if (ev.type == Event::Closed)
 			m_window.close();
 
+		// Render statistics: F3 toggles the overlay, F4 toggles CSV recording
+		if (ev.type == Event::KeyPressed && ev.key.code == Keyboard::F3) {
+			m_showRenderStats = !m_showRenderStats;
+		}
+		if (ev.type == Event::KeyPressed && ev.key.code == Keyboard::F4) {
+			if (m_renderer.IsCsvActive()) m_renderer.StopCsv();
+			else m_renderer.StartCsv("render_stats.csv");
+		}
+		if (ev.type == Event::KeyPressed && ev.key.code == Keyboard::F5) {
+			m_dynamicRes.SetEnabled(!m_dynamicRes.IsEnabled());
+		}
+		// F6 cycles the parallax overdraw heat-map views
+		if (ev.type == Event::KeyPressed && ev.key.code == Keyboard::F6 && m_worldView) {
+			m_worldView->cycleParallaxView();
+		}
+
 
 		
 
@@ -359,36 +496,9 @@ void Game::processEvents()
 			else if (m_state == GameState::PLAYING) {
 				// Toggle pause
 				m_paused = !m_paused;
-				if (m_paused) {
-					// Pause audio emitters and music
-					// store previous statuses and pause
-					m_emitterPrevStatus.clear();
-					if (m_dialogueEmitter && m_dialogueEmitter->buffer) m_emitterPrevStatus["dialogue"] = m_dialogueEmitter->sound.getStatus(), m_dialogueEmitter->sound.pause();
-					if (m_effectEmitter && m_effectEmitter->buffer) m_emitterPrevStatus["effect"] = m_effectEmitter->sound.getStatus(), m_effectEmitter->sound.pause();
-					if (m_playerReply && m_playerReply->buffer) m_emitterPrevStatus["playerReply"] = m_playerReply->sound.getStatus(), m_playerReply->sound.pause();
-					// pause registered player emitters
-					for (auto& kv : m_playerEmitters) {
-						if (kv.second && kv.second->buffer) {
-							m_emitterPrevStatus[kv.first] = kv.second->sound.getStatus();
-							kv.second->sound.pause();
-						}
-					}
-					m_audio.PauseMusic();
-				}
-				else {
-					// Resume
-					// restore previously playing sounds
-					if (m_dialogueEmitter && m_dialogueEmitter->buffer) { if (m_emitterPrevStatus["dialogue"] == sf::Sound::Playing) m_dialogueEmitter->sound.play(); }
-					if (m_effectEmitter && m_effectEmitter->buffer) { if (m_emitterPrevStatus["effect"] == sf::Sound::Playing) m_effectEmitter->sound.play(); }
-					if (m_playerReply && m_playerReply->buffer) { if (m_emitterPrevStatus["playerReply"] == sf::Sound::Playing) m_playerReply->sound.play(); }
-					for (auto& kv : m_playerEmitters) {
-						auto it = m_emitterPrevStatus.find(kv.first);
-						if (it != m_emitterPrevStatus.end() && it->second == sf::Sound::Playing) {
-							if (kv.second && kv.second->buffer) kv.second->sound.play();
-						}
-					}
-					m_audio.ResumeMusic();
-				}
+				// The master bus holds every emitter and the music where they are
+				if (m_paused) m_audio.PauseBus(AudioBus::Master);
+				else m_audio.ResumeBus(AudioBus::Master);
 
 				// If we paused, do not perform menu reset logic below.
 				if (m_paused) continue;
@@ -426,25 +536,16 @@ void Game::processEvents()
 				if (m_pauseResumeButton->Contains(world)) {
 					// resume
 					m_paused = false;
-					// restore audio (same logic as key handler)
-					if (m_dialogueEmitter && m_dialogueEmitter->buffer) { if (m_emitterPrevStatus["dialogue"] == sf::Sound::Playing) m_dialogueEmitter->sound.play(); }
-					if (m_effectEmitter && m_effectEmitter->buffer) { if (m_emitterPrevStatus["effect"] == sf::Sound::Playing) m_effectEmitter->sound.play(); }
-					if (m_playerReply && m_playerReply->buffer) { if (m_emitterPrevStatus["playerReply"] == sf::Sound::Playing) m_playerReply->sound.play(); }
-					for (auto& kv : m_playerEmitters) {
-						auto it = m_emitterPrevStatus.find(kv.first);
-						if (it != m_emitterPrevStatus.end() && it->second == sf::Sound::Playing) {
-							if (kv.second && kv.second->buffer) kv.second->sound.play();
-						}
-					}
-					m_audio.ResumeMusic();
+					m_audio.ResumeBus(AudioBus::Master);
 				}
 				else if (m_pauseBackButton->Contains(world)) {
 					// Back to menu
 					m_paused = false;
 					m_state = GameState::MENU;
 					m_audio.StopMusic();
-					m_dialogueEmitter->stop();
-					m_effectEmitter->stop();
+					m_audio.Stop(m_dialogueEmitter);
+					m_audio.Stop(m_effectEmitter);
+					m_audio.ResumeBus(AudioBus::Master);
 					if (m_mainMenu) m_mainMenu->ResetMobileVisual();
 
 					// Reset gameplay state and timers while in menu so they don't accumulate
@@ -496,15 +597,13 @@ void Game::processEvents()
 			nextInputLockCheck = randomFloat(3.f, 6.f);
 		}
 		if (ev.type == Event::KeyPressed && ev.key.code == Keyboard::Num1) {
-			if (m_dialogueEmitter->buffer) m_dialogueEmitter->sound.play();
+			m_audio.Play(m_dialogueEmitter);
 		}
 		if (ev.type == Event::KeyPressed && ev.key.code == Keyboard::Num2) {
-			if (m_effectEmitter->buffer) m_effectEmitter->sound.play();
+			m_audio.Play(m_effectEmitter);
 		}
 		if (ev.type == Event::KeyPressed && ev.key.code == Keyboard::Y) {
-			if (m_playerReply && m_playerReply->buffer) {
-				m_playerReply->sound.play();
-			}
+			m_audio.Play(m_playerReply);
 		}
 	}
 }
@@ -568,21 +667,15 @@ void Game::ResetGameplay(bool resetPlayerPosition)
 	m_transitionStartRotation = 0.f;
 	m_transitionTargetRotation = 0.f;
 
-	// Reset player emitters: stop them and set position to player
-	b2Vec2 playerPos = { 0.f,0.f };
-	if (m_player && m_player->GetBody()) playerPos = m_player->GetBody()->GetPosition();
+	// Reset player emitters (they follow the player's body)
 	for (auto& [id, emitter] : m_playerEmitters) {
-		if (emitter) {
-			emitter->sound.stop();
-			emitter->sound.setPlayingOffset(sf::Time::Zero);
-			emitter->position = playerPos;
-		}
+		m_audio.Stop(emitter);
 	}
 
 	// Reset dedicated emitters
-	if (m_dialogueEmitter) { m_dialogueEmitter->sound.stop(); m_dialogueEmitter->sound.setPlayingOffset(sf::Time::Zero); }
-	if (m_effectEmitter) { m_effectEmitter->sound.stop(); m_effectEmitter->sound.setPlayingOffset(sf::Time::Zero); }
-	if (m_playerReply) { m_playerReply->sound.stop(); m_playerReply->sound.setPlayingOffset(sf::Time::Zero); }
+	m_audio.Stop(m_dialogueEmitter);
+	m_audio.Stop(m_effectEmitter);
+	m_audio.Stop(m_playerReply);
 
 	// Grocery / obstacle audio state + timers
 	m_groceryCollisionPlayed = false;
@@ -592,13 +685,10 @@ void Game::ResetGameplay(bool resetPlayerPosition)
 	m_nextGroceryLineTime = randomFloat(5.f, 10.f);
 	m_groceryCooldownClock.restart();
 
-	// If grocery emitter exists, update its position to match obstacle
-	if (m_groceryObstacleIndex >= 0 && m_worldView) {
-		b2Vec2 gpos = m_worldView->getObstacleBodyPosition(m_groceryObstacleIndex);
-		if (m_groceryA) { m_groceryA->sound.stop(); m_groceryA->sound.setPlayingOffset(sf::Time::Zero); m_groceryA->position = gpos; }
-		if (m_groceryB) { m_groceryB->sound.stop(); m_groceryB->sound.setPlayingOffset(sf::Time::Zero); m_groceryB->position = gpos; }
-		if (m_groceryCollision) { m_groceryCollision->sound.stop(); m_groceryCollision->sound.setPlayingOffset(sf::Time::Zero); m_groceryCollision->position = gpos; }
-	}
+	// Grocery emitters follow the obstacle's body; just silence them
+	m_audio.Stop(m_groceryA);
+	m_audio.Stop(m_groceryB);
+	m_audio.Stop(m_groceryCollision);
 
 	// Preserve user's mixer volumes set via Options during the current run.
 	// Do not overwrite m_audio volume sliders here.
@@ -631,8 +721,8 @@ void Game::SpawnBus()
 	float busY = 940.f; // a bit below the player; tweak as needed
 
 	Bus b;
-	b.sprite.setTexture(m_busTexture);
-	b.sprite.setOrigin(m_busTexture.getSize().x * 0.5f, m_busTexture.getSize().y * 0.5f);
+	b.sprite.setTexture(*m_busTexture);
+	b.sprite.setOrigin(m_busTexture->getSize().x * 0.5f, m_busTexture->getSize().y * 0.5f);
 	// optional scaling:
 	b.sprite.setScale(1.5f, 1.5f);
 
@@ -644,16 +734,13 @@ void Game::SpawnBus()
 
 	// Play audio immediately when spawning:
 	b.playedEmitter = true; // mark true so update() won't replay at mid-point
-	if (m_busEmitter && m_busEmitter->buffer) {
-		// set emitter to spawn position (meters)
-		m_busEmitter->position = b2Vec2(b.startPos.x * INV_PPM, b.startPos.y * INV_PPM);
-		m_busEmitter->sound.stop();   // ensure restart
-		m_busEmitter->sound.play();   // play right away
-	}
-
 	b.sprite.setPosition(b.startPos);
 
 	m_buses.push_back(std::move(b));
+
+	// The emitter follows the newest bus (update() re-points it as buses come and go)
+	m_audio.AttachToSprite(m_busEmitter, &m_buses.back().sprite, PPM);
+	m_audio.Play(m_busEmitter);   // play right away; an earlier pass keeps playing
 }
 
 
@@ -682,7 +769,7 @@ void Game::update(float dt)
 
 		// Stop player emitters (optional)
 		for (auto& kv : m_playerEmitters) {
-			if (kv.second && kv.second->buffer) kv.second->sound.stop();
+			m_audio.Stop(kv.second);
 		}
 
 		// NOTE: we DO NOT return here. We'll still run the countdown check later in this function.
@@ -755,8 +842,8 @@ void Game::update(float dt)
 		if (inputLocked) {
 			if (!refusePlayed) {
 				auto it = m_playerEmitters.find("refuse");
-				if (it != m_playerEmitters.end() && it->second) {
-					it->second->sound.play();
+				if (it != m_playerEmitters.end()) {
+					m_audio.Play(it->second);
 				}
 				if (inputLocked && !wavePlayed)
 				{
@@ -913,11 +1000,7 @@ void Game::update(float dt)
 	}
 
 
-	// Update player emitter positions
 	b2Vec2 playerPos = m_player->GetBody()->GetPosition();
-	for (auto& [id, emitter] : m_playerEmitters) {
-		emitter->position = playerPos;
-	}
 
 	// Collision detection
 	if (m_worldView && m_player) {
@@ -981,11 +1064,11 @@ void Game::update(float dt)
 
  			// Stop music & emitters so the scene is quiet while counting down
  			m_audio.StopMusic();
- 			if (m_dialogueEmitter && m_dialogueEmitter->buffer) m_dialogueEmitter->sound.stop();
- 			if (m_effectEmitter && m_effectEmitter->buffer) m_effectEmitter->sound.stop();
- 			if (m_playerReply && m_playerReply->buffer) m_playerReply->sound.stop();
+ 			m_audio.Stop(m_dialogueEmitter);
+ 			m_audio.Stop(m_effectEmitter);
+ 			m_audio.Stop(m_playerReply);
  			for (auto& kv : m_playerEmitters) {
- 				if (kv.second && kv.second->buffer) kv.second->sound.stop();
+ 				m_audio.Stop(kv.second);
  			}
 
  			// Prepare the "YOU LOSE" text
@@ -1019,16 +1102,6 @@ void Game::update(float dt)
 		}
 
 
-		// ----- Grocery: update emitter positions -----
-		// ----- Grocery: update emitter positions -----
-		if (m_groceryObstacleIndex >= 0)
-		{
-			b2Vec2 gpos = m_worldView->getObstacleBodyPosition(m_groceryObstacleIndex);
-			if (m_groceryA) m_groceryA->position = gpos;
-			if (m_groceryB) m_groceryB->position = gpos;
-			if (m_groceryCollision) m_groceryCollision->position = gpos;
-		}
-
 		// ---- Grocery: collision vs ambient behavior ----
 		bool collidingWithGrocery = (m_worldView->getLastCollidedObstacleIndex() == m_groceryObstacleIndex);
 
@@ -1046,16 +1119,15 @@ void Game::update(float dt)
 			if (collidingWithGrocery)
 			{
 				// Stop ambient lines so collision line is clean
-				if (m_groceryA && m_groceryA->sound.getStatus() == sf::Sound::Playing) m_groceryA->sound.stop();
-				if (m_groceryB && m_groceryB->sound.getStatus() == sf::Sound::Playing) m_groceryB->sound.stop();
+				if (m_audio.GetStatus(m_groceryA) == sf::Sound::Playing) m_audio.Stop(m_groceryA);
+				if (m_audio.GetStatus(m_groceryB) == sf::Sound::Playing) m_audio.Stop(m_groceryB);
 
 				// If we haven't yet started the collision sequence for this contact, start it
 				// but only if cooldown is NOT active
 				if (!m_groceryCollisionPlayed && !m_groceryCooldownActive)
 				{
-					if (m_groceryCollision && m_groceryCollision->buffer) {
-						m_groceryCollision->sound.stop(); // ensure restart
-						m_groceryCollision->sound.play();
+					if (m_audio.IsLoaded(m_groceryCollision)) {
+						m_audio.Play(m_groceryCollision);
 						m_groceryWaitingPlayerReply = true; // wait until grocery line finishes (persist even if player leaves)
 						std::cerr << "DEBUG: grocery collision line started\n";
 					}
@@ -1075,16 +1147,16 @@ void Game::update(float dt)
 						m_nextGroceryLineTime = randomFloat(5.f, 10.f);
 
 						// skip playing if any ambient is already playing
-						if (m_groceryA && m_groceryA->buffer && m_groceryA->sound.getStatus() != sf::Sound::Playing &&
-							m_groceryB && m_groceryB->buffer && m_groceryB->sound.getStatus() != sf::Sound::Playing)
+						if (m_audio.IsLoaded(m_groceryA) && m_audio.GetStatus(m_groceryA) != sf::Sound::Playing &&
+							m_audio.IsLoaded(m_groceryB) && m_audio.GetStatus(m_groceryB) != sf::Sound::Playing)
 						{
 							if (rand() % 2 == 0)
 							{
-								if (m_groceryA && m_groceryA->buffer) m_groceryA->sound.play();
+								m_audio.Play(m_groceryA);
 							}
 							else
 							{
-								if (m_groceryB && m_groceryB->buffer) m_groceryB->sound.play();
+								m_audio.Play(m_groceryB);
 							}
 						}
 					}
@@ -1097,18 +1169,17 @@ void Game::update(float dt)
 			{
 				// Guard: if grocery emitter exists, wait until it reports Stopped
 				bool groceryStopped = true; // default true if no emitter (fallback)
-				if (m_groceryCollision && m_groceryCollision->buffer) {
-					groceryStopped = (m_groceryCollision->sound.getStatus() == sf::Sound::Stopped);
+				if (m_audio.IsLoaded(m_groceryCollision)) {
+					groceryStopped = (m_audio.GetStatus(m_groceryCollision) == sf::Sound::Stopped);
 				}
 
 				if (groceryStopped)
 				{
 					// Play player reply exactly like "refuse" (from map)
 					auto itReply = m_playerEmitters.find("player_reply");
-					if (itReply != m_playerEmitters.end() && itReply->second && itReply->second->buffer) {
-						// restart to ensure we always hear it
-						itReply->second->sound.stop();
-						itReply->second->sound.play();
+					if (itReply != m_playerEmitters.end() && m_audio.IsLoaded(itReply->second)) {
+						// a new instance, so we always hear it from the start
+						m_audio.Play(itReply->second);
 						std::cerr << "DEBUG: played player_reply after grocery finished\n";
 					}
 					else {
@@ -1140,16 +1211,16 @@ void Game::update(float dt)
 				m_nextGroceryLineTime = randomFloat(5.f, 10.f);
 
 				// skip playing if grocery collision emitter is mid-play (unlikely since not colliding)
-				if (m_groceryA && m_groceryA->buffer && m_groceryA->sound.getStatus() != sf::Sound::Playing &&
-					m_groceryB && m_groceryB->buffer && m_groceryB->sound.getStatus() != sf::Sound::Playing)
+				if (m_audio.IsLoaded(m_groceryA) && m_audio.GetStatus(m_groceryA) != sf::Sound::Playing &&
+					m_audio.IsLoaded(m_groceryB) && m_audio.GetStatus(m_groceryB) != sf::Sound::Playing)
 				{
 					if (rand() % 2 == 0)
 					{
-						if (m_groceryA && m_groceryA->buffer) m_groceryA->sound.play();
+						m_audio.Play(m_groceryA);
 					}
 					else
 					{
-						if (m_groceryB && m_groceryB->buffer) m_groceryB->sound.play();
+						m_audio.Play(m_groceryB);
 					}
 				}
 				else
@@ -1182,17 +1253,9 @@ void Game::update(float dt)
 			float ny = it->startPos.y + (it->endPos.y - it->startPos.y) * t;
 			it->sprite.setPosition(nx, ny);
 
-			// update shared bus emitter position (convert to meters)
-			if (m_busEmitter) {
-				m_busEmitter->position = b2Vec2(nx * INV_PPM, ny * INV_PPM);
-			}
-
 			// Play the bus sound once when crossing middle of the view (t >= 0.5)
 			if (!it->playedEmitter && t >= 0.5f) {
-				if (m_busEmitter && m_busEmitter->buffer) {
-					m_busEmitter->sound.stop();
-					m_busEmitter->sound.play();
-				}
+				m_audio.Play(m_busEmitter);
 				it->playedEmitter = true;
 			}
 
@@ -1200,7 +1263,7 @@ void Game::update(float dt)
 			if (it->progress >= 1.f) {
 				it->active = false;
 				// stop emitter if still playing
-				if (m_busEmitter) m_busEmitter->sound.stop();
+				m_audio.Stop(m_busEmitter);
 				it = m_buses.erase(it);
 				continue;
 			}
@@ -1208,6 +1271,10 @@ void Game::update(float dt)
 			++it;
 		}
 
+		// Erasing shifts the vector, so point the bus emitter at the newest bus again
+		if (m_buses.empty()) m_audio.Detach(m_busEmitter);
+		else m_audio.AttachToSprite(m_busEmitter, &m_buses.back().sprite, PPM);
+
 
 
 
@@ -1221,23 +1288,57 @@ void Game::update(float dt)
 		m_lastAppliedAudioState = cur;
 	}
 
+	// Bus inserts follow the persona and the place. Only the software mixer
+	// (--bus-effects) has inserts on the sound effect buses; without it the
+	// sewer reverb goes on the music and the psycho muffle is left out
+	const bool busInserts = m_audio.Mixer() != nullptr;
+	if (psychoMode != m_audioMuffled) {
+		const float cutoff = psychoMode ? PSYCHO_LOWPASS_HZ : 0.f;
+		if (busInserts) {
+			m_audio.SetBusLowPass(AudioBus::Background, cutoff);
+			m_audio.SetBusLowPass(AudioBus::Effects, cutoff);
+		}
+		m_audioMuffled = psychoMode;
+	}
+	bool inSewer = false;
+	for (int index : m_sewerObstacles)
+		inSewer = inSewer || b2Distance(playerPos, m_worldView->getObstacleBodyPosition(index)) < SEWER_REVERB_RADIUS;
+	if (inSewer != m_audioInSewer) {
+		const float wet = inSewer ? SEWER_REVERB_WET : 0.f;
+		if (busInserts) {
+			for (AudioBus bus : { AudioBus::Background, AudioBus::Dialogue, AudioBus::Effects })
+				m_audio.SetBusReverb(bus, wet);
+		}
+		else {
+			m_audio.SetBusReverb(AudioBus::Music, wet);
+		}
+		m_audioInSewer = inSewer;
+	}
+
 	m_audio.Update(dt, playerPos);
 }
 
 void Game::render()
 {
+	m_renderer.BeginFrame();
+
 	if (m_state == GameState::MENU) {
-		m_window.setView(m_defaultView);
-		m_window.clear(Color(20, 20, 30));
-		m_mainMenu->Render(m_window);
+		m_renderer.BeginPass(RenderPass::UI);
+		m_renderer.SetView(m_defaultView);
+		m_renderer.Clear(Color(20, 20, 30));
+		m_mainMenu->Render(m_renderer);
+		drawStatsOverlay();
+		m_renderer.EndFrame();
 		m_window.display();
 		return;
 	}
 
 	m_player->SyncGraphics();
 
-	m_diagMark.setPosition(m_dialogueEmitter->position.x * PPM, m_dialogueEmitter->position.y * PPM);
-	m_fxMark.setPosition(m_effectEmitter->position.x * PPM, m_effectEmitter->position.y * PPM);
+	const b2Vec2 diagPos = m_audio.GetPosition(m_dialogueEmitter);
+	const b2Vec2 fxPos = m_audio.GetPosition(m_effectEmitter);
+	m_diagMark.setPosition(diagPos.x * PPM, diagPos.y * PPM);
+	m_fxMark.setPosition(fxPos.x * PPM, fxPos.y * PPM);
 
 	b2Vec2 pos = m_player->GetBody()->GetPosition();
 	Vector2f playerPosPixels(pos.x * PPM, pos.y * PPM);
@@ -1251,57 +1352,81 @@ void Game::render()
 		camCenter.y += randomOffset(PSYCHO_SHAKE_MAG);
 	}
 	m_camera.setCenter(camCenter);
-	m_window.setView(m_camera);
+	m_renderer.BeginPass(RenderPass::Background);
 
-	m_window.clear(Color::Black);
+	// World pass goes off-screen at a reduced scale when frame time demands it
+	const bool scaledWorld = m_dynamicRes.IsActive();
+	if (scaledWorld) {
+		m_renderer.SetTarget(m_dynamicRes.Target());
+		m_renderer.SetView(m_dynamicRes.ScaledView(m_camera));
+	}
+	else {
+		m_renderer.SetView(m_camera);
+	}
+
+	m_renderer.Clear(Color::Black);
 
 	if (m_worldView) {
 		// Draw background layers and obstacles
-		m_worldView->drawParallaxBackground(m_window);
-		m_worldView->draw(m_window); // draw obstacles
+		m_worldView->drawParallaxBackground(m_renderer);
+		m_worldView->draw(m_renderer); // draw obstacles
 	}
 
 	// Draw player
-	m_player->Draw(m_window);
+	m_renderer.BeginPass(RenderPass::Player);
+	m_player->Draw(m_renderer);
 
 
+	m_renderer.BeginPass(RenderPass::Obstacles);
 	for (auto& bus : m_buses) {
 		if (bus.active) {
-			m_window.draw(bus.sprite);
+			m_renderer.Draw(bus.sprite);
 		}
 	}
 	// Draw foreground layers
 	if (m_worldView) {
-		m_worldView->drawParallaxForeground(m_window);
+		m_worldView->drawParallaxForeground(m_renderer);
 	}
 
-	m_window.draw(m_diagMark);
-	m_window.draw(m_fxMark);
+	m_renderer.BeginPass(RenderPass::UI);
+	m_renderer.Draw(m_diagMark);
+	m_renderer.Draw(m_fxMark);
+
+	// Everything below stays at native resolution
+	if (scaledWorld) {
+		m_renderer.SetTarget(m_window);
+		m_renderer.SetView(m_defaultView);
+		m_renderer.Clear(Color::Black);
+		m_dynamicRes.Present(m_renderer);
+	}
 
 	// Pause overlay + buttons
-	m_window.setView(m_defaultView);
+	m_renderer.SetView(m_defaultView);
 	if (m_paused) {
-		m_window.draw(m_pauseOverlay);
-		m_pauseResumeButton->Draw(m_window);
-		m_pauseBackButton->Draw(m_window);
+		m_renderer.Draw(m_pauseOverlay);
+		m_pauseResumeButton->Draw(m_renderer);
+		m_pauseBackButton->Draw(m_renderer);
 	}
 
-	m_window.setView(m_defaultView);
-	std::string s = std::string("State: PLAYING\n") +
-		"PsychoMode: " + (psychoMode ? "ON" : "OFF") + "\n" +
-		"InputLock: " + (inputLocked ? std::string("LOCKED") : std::string("FREE")) + "\n" +
-		"SplitMode: " + (splitMode ? std::string("ON") : std::string("OFF")) + "\n" +
-		"Controls: A/D move, W jump (inverted when psycho)\n" +
-		"P: force toggle psycho | M: toggle music vol | B: toggle bg vol\n" +
-		"1: play dialogue one-shot |2: play effect one-shot\n" +
-		"ESC: back to menu";
-	m_debugText.setString(s);
-	m_window.draw(m_debugText);
+	// Only rebuild the debug text when one of the flags it shows changes
+	const int debugKey = (psychoMode ? 1 : 0) | (inputLocked ? 2 : 0) | (splitMode ? 4 : 0);
+	if (debugKey != m_debugTextKey) {
+		m_debugTextKey = debugKey;
+		std::string s = std::string("State: PLAYING\n") +
+			"PsychoMode: " + (psychoMode ? "ON" : "OFF") + "\n" +
+			"InputLock: " + (inputLocked ? std::string("LOCKED") : std::string("FREE")) + "\n" +
+			"SplitMode: " + (splitMode ? std::string("ON") : std::string("OFF")) + "\n" +
+			"Controls: A/D move, W jump (inverted when psycho)\n" +
+			"P: force toggle psycho | M: toggle music vol | B: toggle bg vol\n" +
+			"1: play dialogue one-shot |2: play effect one-shot\n" +
+			"ESC: back to menu";
+		m_debugText.SetString(s);
+	}
+	m_renderer.Draw(m_debugText.Text());
 
 	// Draw game-over HUD if active
 	if (m_gameOver) {
 		// draw the text in the default (screen) view so it appears as HUD and not world-space
-		m_window.setView(m_defaultView);
 
 		// Position the text near the top-center (adjust vertical offset as you like)
 		sf::Vector2f dvCenter = m_defaultView.getCenter();
@@ -1311,23 +1436,31 @@ void Game::render()
 		float remaining = m_gameOverDelay - m_gameOverClock.getElapsedTime().asSeconds();
 		if (remaining < 0.f) remaining = 0.f;
 		int secs = static_cast<int>(std::ceil(remaining));
-		sf::Text countdown;
-		countdown.setFont(m_font);
-		countdown.setCharacterSize(42);
-		countdown.setFillColor(sf::Color::White);
-		countdown.setStyle(sf::Text::Bold);
-		countdown.setString(std::to_string(secs));
-		sf::FloatRect cb = countdown.getLocalBounds();
-		countdown.setOrigin(cb.left + cb.width * 0.5f, cb.top + cb.height * 0.5f);
-		countdown.setPosition(dvCenter.x, dvCenter.y - (m_window.getSize().y * 0.22f));
-
-		m_window.draw(m_gameOverText);
-		m_window.draw(countdown);
-
-		// restore camera view for other UI or future draws
-		m_window.setView(m_camera);
+		m_countdownText.SetString(std::to_string(secs));
+		m_countdownText.SetPosition({ dvCenter.x, dvCenter.y - (m_window.getSize().y * 0.22f) });
+
+		m_renderer.Draw(m_gameOverText);
+		m_renderer.Draw(m_countdownText.Text());
 	}
 
+	drawStatsOverlay();
 
+	m_renderer.EndFrame();
 	m_window.display();
 }
+
+void Game::drawStatsOverlay()
+{
+	if (!m_showRenderStats) return;
+	// Shows the previous (complete) frame; this overlay is counted in the current one
+	m_statsText.setString("World scale " + std::to_string(static_cast<int>(m_dynamicRes.Scale() * 100.f + 0.5f)) + "%" +
+		(m_dynamicRes.IsEnabled() ? "" : " (off)") + "\n" +
+		(m_worldView ? m_worldView->parallaxSummary() + "\n" : std::string()) +
+		ResourceCache::Shared().Summary() + "\n" +
+		"Voices " + std::to_string(m_audio.Voices().ActiveVoices()) + "/" + std::to_string(m_audio.Voices().Capacity()) +
+		", stolen " + std::to_string(m_audio.Voices().Steals()) + "\n" +
+		m_audio.InsertsSummary() + "\n" +
+		SoundBank::Shared().Summary() + "\n" +
+		"draws / tex binds / verts / states\n" + m_renderer.Summary());
+	m_renderer.Draw(m_statsText);
+}
@@ -9,6 +9,11 @@
 #include "AudioManager.h"
 #include "Player.h"
 #include "MainMenu.h"
+#include "Renderer.h"
+#include "DynamicResolution.h"
+#include "RetainedText.h"
+#include "ResourceCache.h"
+#include "AsyncLoader.h"
 #include <vector>
 
 class World; // forward declaration
@@ -36,6 +41,12 @@ public:
     ~Game();
     void ResetGameplay(bool resetPlayerPosition = true);
 
+    // Mix sound effects in software so the psycho low-pass and sewer reverb
+    // apply to them. Off by default: the mixer adds up to about 40 ms before
+    // a triggered sound is heard, and the sewer reverb then goes on the
+    // music instead. Takes effect when gameplay is built.
+    void SetBusEffects(bool enabled) { m_busEffects = enabled; }
+
     int Run();
 
 private:
@@ -54,9 +65,20 @@ private:
     void SpawnBus();
     void render();
 
+    // Gameplay objects are built once their assets are resident; until
+    // then the menu is up and Run() pumps the loader every frame
+    void queueGameplayAssets();
+    void pumpLoader();
+    void buildGameplay();
+    std::unique_ptr<AsyncLoader> m_loader;
+    std::size_t m_buildStep = 0; // steps of pumpLoader done after the loader finished
+    bool m_gameplayReady = false;
+
 private:
     // SFML
     sf::RenderWindow m_window;
+    Renderer m_renderer;      // counts draws / binds / vertices per pass
+    DynamicResolution m_dynamicRes; // world pass render scale (F5 toggles)
     sf::View m_camera;
     sf::View m_defaultView;
 
@@ -86,16 +108,26 @@ private:
 
     // Audio
     AudioManager m_audio;
-    std::shared_ptr<AudioEmitter> m_dialogueEmitter;
-    std::shared_ptr<AudioEmitter> m_effectEmitter;
+    EmitterHandle m_dialogueEmitter;
+    EmitterHandle m_effectEmitter;
+
+    // Bus inserts: psycho mode muffles the world, the sewers add a short room
+    std::vector<int> m_sewerObstacles;
+    bool m_audioMuffled = false;
+    bool m_audioInSewer = false;
+    bool m_busEffects = false;
+    static constexpr float PSYCHO_LOWPASS_HZ = 900.f;
+    static constexpr float SEWER_REVERB_RADIUS = 4.f; // meters from a sewer cap
+    static constexpr float SEWER_REVERB_WET = 0.35f;
+    static constexpr std::size_t SOUND_BANK_BUDGET = 4 * 1024 * 1024; // decoded PCM kept once unused
 
     //Grocery Man Variables
     // Grocery audio
     int m_groceryObstacleIndex = -1;
-    std::shared_ptr<AudioEmitter> m_groceryA; // ambient line A
-    std::shared_ptr<AudioEmitter> m_groceryB; // ambient line B
-    std::shared_ptr<AudioEmitter> m_groceryCollision; // collision/callout line
-    std::shared_ptr<AudioEmitter> m_playerReply; // add as a private member of Game
+    EmitterHandle m_groceryA; // ambient line A
+    EmitterHandle m_groceryB; // ambient line B
+    EmitterHandle m_groceryCollision; // collision/callout line
+    EmitterHandle m_playerReply; // add as a private member of Game
     bool m_groceryCollisionPlayed = false; // already used, but ensure it's declared as a member
     bool m_groceryWaitingPlayerReply = false;
 
@@ -104,13 +136,13 @@ private:
     bool m_lastGroceryColliding = false;
 
     // Bus system
-    sf::Texture m_busTexture;
+    std::shared_ptr<const sf::Texture> m_busTexture;
     std::vector<Bus> m_buses;
     sf::Clock m_busSpawnClock;
     float m_busSpawnInterval = 10.f;   // every 30 seconds
     float m_busTravelTime = 3.f;       // how long it takes (2s)
     float m_busSpawnMargin = 800.f;    // how far outside the view the bus starts/ends (pixels)
-    std::shared_ptr<AudioEmitter> m_busEmitter; // shared emitter used for bus pass sound
+    EmitterHandle m_busEmitter; // shared emitter used for bus pass sound
     std::string m_busAudioPath = "assets/Audio/bus_pass.wav"; // ensure this file exists
 
 
@@ -145,12 +177,19 @@ private:
     sf::Clock m_gameOverClock;
     float m_gameOverDelay = 3.f;
     sf::Text m_gameOverText;
+    RetainedText m_countdownText;                 // re-shaped only when the whole second changes
     bool m_disableInputDuringGameOver = false;    // prevents handling input while counting down
 
 
     // Debug text / UI
-    sf::Font m_font;
-    sf::Text m_debugText;
+    std::shared_ptr<const sf::Font> m_font;
+    RetainedText m_debugText;
+    int m_debugTextKey = -1;                      // packed flags the debug text was last built from
+
+    // Render statistics overlay (F3) and CSV dump (F4)
+    bool m_showRenderStats = false;
+    sf::Text m_statsText;
+    void drawStatsOverlay();
 
     // Main Menu
     std::unique_ptr<MainMenu> m_mainMenu;
@@ -160,7 +199,6 @@ private:
     std::unique_ptr<MenuButton> m_pauseResumeButton;
     std::unique_ptr<MenuButton> m_pauseBackButton;
     sf::RectangleShape m_pauseOverlay;
-    std::unordered_map<std::string, sf::Sound::Status> m_emitterPrevStatus;
 
     // Frame clock
     sf::Clock m_frameClock;
@@ -1,11 +1,25 @@
 #include "MainMenu.h"
+#include "ResourceCache.h"
 #include <cmath>
 #include <algorithm> // for std::min
 
 static sf::Color ColorWithAlpha(sf::Color c, uint8_t a) { c.a = a; return c; }
 
+// Exponential approach that snaps once close enough, so a settled
+// animation stops changing and the button can skip its layout pass.
+// Returns true if the value moved (a zero dt moves nothing).
+static bool Approach(float& value, float target, float rate)
+{
+    constexpr float SNAP = 0.001f;
+    if (value == target) return false;
+    const float before = value;
+    if (std::abs(target - value) >= SNAP) value += (target - value) * rate;
+    if (std::abs(target - value) < SNAP) value = target;
+    return value != before;
+}
+
 // Persistent background assets for main menu
-static sf::Texture s_mainBgTex;
+static std::shared_ptr<const sf::Texture> s_mainBgTex;
 static sf::Sprite s_mainBgSprite;
 static bool s_mainBgLoaded = false;
 
@@ -41,13 +55,12 @@ MenuButton::MenuButton(const sf::Font& font, const std::string& label, const sf:
     m_bg.setOutlineColor(sf::Color(60, 60, 60));
 
     // Label
-    m_text.setFont(font);
-    m_text.setString(label);
-    m_text.setCharacterSize(28);
-    m_text.setFillColor(sf::Color::White);
-    sf::FloatRect tb = m_text.getLocalBounds();
-    m_text.setOrigin(tb.left + tb.width / 2.f, tb.top + tb.height / 2.f);
-    m_text.setPosition(center);
+    m_text.SetFont(font);
+    m_text.SetCharacterSize(28);
+    m_text.SetFillColor(sf::Color::White);
+    m_text.SetCentered(true);
+    m_text.SetString(label);
+    m_text.SetPosition(center);
 
     // Colored accent bar (left side)
     m_accentBaseHeight = size.y - 8.f;
@@ -57,57 +70,54 @@ MenuButton::MenuButton(const sf::Font& font, const std::string& label, const sf:
     m_accent.setFillColor(sf::Color(120, 70, 255));
 }
 
-void MenuButton::Draw(sf::RenderWindow& window)
+void MenuButton::Draw(Renderer& renderer)
 {
-    window.draw(m_bg);
+    renderer.Draw(m_bg);
 
     if (m_hoverAnim > 0.f) {
-        sf::RectangleShape glow;
-        glow.setSize(m_bg.getSize());
-        glow.setOrigin(m_bg.getOrigin());
-        glow.setPosition(m_bg.getPosition());
-        glow.setFillColor(ColorWithAlpha(sf::Color(120, 70, 255), static_cast<uint8_t>(25 * m_hoverAnim)));
-        window.draw(glow);
+        renderer.Draw(m_glow);
     }
 
-    window.draw(m_accent);
-    window.draw(m_text);
+    renderer.Draw(m_accent);
+    renderer.Draw(m_text.Text());
 }
 
 void MenuButton::Update(float dt, const sf::Vector2f& mousePos)
 {
     // 1) update hover state (doesn't call layout)
-    UpdateHover(mousePos, dt);
+    bool changed = UpdateHover(mousePos, dt);
 
     // 2) advance external/global scale toward its target smoothly
-    m_externalScale += (m_externalScaleTarget - m_externalScale) * std::min(1.f, dt * m_externalScaleSpeed);
+    changed |= Approach(m_externalScale, m_externalScaleTarget, std::min(1.f, dt * m_externalScaleSpeed));
 
     // 3) determine desired accent target (pressed or persistent => full, otherwise idle)
     float desiredAccent = (m_pressing || m_persistentAccent) ? 1.f : 0.f;
-    m_accentAnim += (desiredAccent - m_accentAnim) * std::min(1.f, dt * m_accentAnimSpeed);
+    changed |= Approach(m_accentAnim, desiredAccent, std::min(1.f, dt * m_accentAnimSpeed));
 
     // 4) advance press pulse logic (only modifies press state; layout applied below)
+    changed |= m_pressing;
     UpdatePress(dt);
 
-    // 5) re-apply layout using the updated animation parameters
-    ApplyLayoutWithAnimation();
+    // 5) re-apply layout only when an animation parameter moved
+    if (changed || m_layoutDirty) {
+        ApplyLayoutWithAnimation();
+        m_layoutDirty = false;
+    }
 }
 
-void MenuButton::UpdateHover(const sf::Vector2f& mousePos, float dt)
+bool MenuButton::UpdateHover(const sf::Vector2f& mousePos, float dt)
 {
-    m_hovered = m_enabled && sf::FloatRect(
-        m_baseCenter.x - m_baseSize.x * 0.5f,
-        m_baseCenter.y - m_baseSize.y * 0.5f,
-        m_baseSize.x,
-        m_baseSize.y
-    ).contains(mousePos);
-
-    const float target = m_hovered ? 1.f : 0.f;
-    m_hoverAnim += (target - m_hoverAnim) * std::min(1.f, dt * m_hoverSpeed);
+    const bool hovered = m_enabled && Contains(mousePos);
+    const bool hoverChanged = hovered != m_hovered;
+    m_hovered = hovered;
 
     // Outline color based on hover
-    sf::Color outline = m_hovered ? sf::Color(150, 120, 255) : sf::Color(60, 60, 60);
-    m_bg.setOutlineColor(outline);
+    if (hoverChanged) {
+        m_bg.setOutlineColor(m_hovered ? sf::Color(150, 120, 255) : sf::Color(60, 60, 60));
+    }
+
+    const float target = m_hovered ? 1.f : 0.f;
+    return Approach(m_hoverAnim, target, std::min(1.f, dt * m_hoverSpeed)) || hoverChanged;
 }
 
 void MenuButton::ApplyLayoutWithAnimation()
@@ -131,6 +141,11 @@ void MenuButton::ApplyLayoutWithAnimation()
     m_bg.setOrigin(finalSize * 0.5f);
     m_bg.setPosition(m_baseCenter);
 
+    m_glow.setSize(finalSize);
+    m_glow.setOrigin(finalSize * 0.5f);
+    m_glow.setPosition(m_baseCenter);
+    m_glow.setFillColor(ColorWithAlpha(sf::Color(120, 70, 255), static_cast<uint8_t>(25 * m_hoverAnim)));
+
     // ACCENT EFFECT:
     // We drive accent width by m_accentAnim (0..1) which animates smoothly to target
     float accentHeight = m_accentBaseHeight + 10.f * m_hoverAnim;
@@ -150,16 +165,16 @@ void MenuButton::ApplyLayoutWithAnimation()
     m_accent.setPosition(accentX, m_baseCenter.y);
 
     // Text: keep centered; during press, slightly tint for contrast
-    m_text.setPosition(m_baseCenter);
+    m_text.SetPosition(m_baseCenter);
     float textScale = 1.f + 0.04f * pressEase;
     // apply external scale to text as well (so it scales consistently)
-    m_text.setScale(textScale * m_externalScale, textScale * m_externalScale);
+    m_text.SetScale(textScale * m_externalScale);
 
     if (m_pressing) {
-        m_text.setFillColor(sf::Color(240, 240, 255));
+        m_text.SetFillColor(sf::Color(240, 240, 255));
     }
     else {
-        m_text.setFillColor(m_hovered ? sf::Color(230, 230, 255) : sf::Color::White);
+        m_text.SetFillColor(m_hovered ? sf::Color(230, 230, 255) : sf::Color::White);
     }
 }
 
@@ -167,6 +182,7 @@ void MenuButton::TriggerPressAnim()
 {
     m_pressing = true;
     m_pressPulse = 0.f;
+    m_layoutDirty = true;
 }
 
 void MenuButton::UpdatePress(float dt)
@@ -179,6 +195,7 @@ void MenuButton::UpdatePress(float dt)
     if (m_pressPulse >= m_pressDuration) {
         m_pressing = false;
         m_pressPulse = 0.f;
+        m_layoutDirty = true; // settle the pop back to rest
 
         // If not persistent, accent will now animate back because m_accentAnim target becomes 0
     }
@@ -195,7 +212,8 @@ void MenuButton::SetEnabled(bool enabled)
 {
     m_enabled = enabled;
     m_bg.setFillColor(enabled ? sf::Color(25, 25, 25) : sf::Color(60, 60, 60));
-    m_text.setFillColor(enabled ? sf::Color::White : sf::Color(200, 200, 200));
+    m_text.SetFillColor(enabled ? sf::Color::White : sf::Color(200, 200, 200));
+    m_layoutDirty = true;
 }
 
 /* ---------------- MainMenu ---------------- */
@@ -214,9 +232,9 @@ MainMenu::MainMenu(const sf::Vector2u& windowSize)
 
     // Load main background once
     if (!s_mainBgLoaded) {
-        if (s_mainBgTex.loadFromFile("Assets/MainMenu/mainbg.jpg")) {
-            s_mainBgTex.setSmooth(true);
-            s_mainBgSprite.setTexture(s_mainBgTex, true);
+        s_mainBgTex = ResourceCache::Shared().GetTexture("Assets/MainMenu/mainbg.jpg", /*smooth=*/true);
+        if (s_mainBgTex) {
+            s_mainBgSprite.setTexture(*s_mainBgTex, true);
             FitSpriteToSize(s_mainBgSprite, m_windowSize);
             s_mainBgLoaded = true;
         }
@@ -239,15 +257,14 @@ void MainMenu::BuildLayout()
 {
     if (!m_font) return;
 
-    if (m_mobileTex1.loadFromFile("Assets/MainMenu/mobile1.png") &&
-        m_mobileTex2.loadFromFile("Assets/MainMenu/mobile2.png"))
+    m_mobileTex1 = ResourceCache::Shared().GetTexture("Assets/MainMenu/mobile1.png", /*smooth=*/true);
+    m_mobileTex2 = ResourceCache::Shared().GetTexture("Assets/MainMenu/mobile2.png", /*smooth=*/true);
+    if (m_mobileTex1 && m_mobileTex2)
     {
         m_mobileLoaded = true;
-        m_mobileTex1.setSmooth(true);
-        m_mobileTex2.setSmooth(true);
 
-        m_mobileSprite.setTexture(m_mobileTex1, true);
-        const auto sz = m_mobileTex1.getSize();
+        m_mobileSprite.setTexture(*m_mobileTex1, true);
+        const auto sz = m_mobileTex1->getSize();
         m_mobileSprite.setOrigin(static_cast<float>(sz.x) * 0.5f, static_cast<float>(sz.y) * 0.5f);
         m_mobileSprite.setPosition(static_cast<float>(m_windowSize.x) * 0.5f, static_cast<float>(m_windowSize.y) * 0.5f);
         m_mobileSprite.setScale(1.f, 1.f);
@@ -276,6 +293,27 @@ void MainMenu::BuildLayout()
     m_buttons.emplace_back(play);     // index 0
     m_buttons.emplace_back(options);  // index 1
     m_buttons.emplace_back(exit);     // index 2
+
+    const float barY = startY + gap * 2.6f;
+    m_loadingTrack.setSize({ btnSize.x, 6.f });
+    m_loadingTrack.setOrigin(btnSize.x * 0.5f, 3.f);
+    m_loadingTrack.setPosition(cx, barY);
+    m_loadingTrack.setFillColor(sf::Color(0, 0, 0, 90));
+    m_loadingBar.setPosition(cx - btnSize.x * 0.5f, barY - 3.f);
+    m_loadingBar.setFillColor(sf::Color(255, 255, 255, 220));
+    m_loadingText.SetFont(*m_font);
+    m_loadingText.SetCharacterSize(18);
+    m_loadingText.SetFillColor(sf::Color::White);
+    m_loadingText.SetCentered(true);
+    m_loadingText.SetPosition({ cx, barY + 18.f });
+    SetLoadingProgress(m_loadingProgress);
+}
+
+void MainMenu::SetLoadingProgress(float progress)
+{
+    m_loadingProgress = std::clamp(progress, 0.f, 1.f);
+    m_loadingBar.setSize({ m_loadingTrack.getSize().x * m_loadingProgress, 6.f });
+    m_loadingText.SetString("Loading " + std::to_string(static_cast<int>(m_loadingProgress * 100.f)) + "%");
 }
 
 void MainMenu::TriggerMobilePressAnim()
@@ -283,7 +321,7 @@ void MainMenu::TriggerMobilePressAnim()
     if (!m_mobileLoaded) return;
     m_mobilePressed = true;
     m_mobilePulse = 0.f;
-    m_mobileSprite.setTexture(m_mobileTex2, true);
+    m_mobileSprite.setTexture(*m_mobileTex2, true);
 }
 
 void MainMenu::Update(float dt, const sf::RenderWindow& /*window*/)
@@ -313,26 +351,32 @@ void MainMenu::Update(float dt, const sf::RenderWindow& /*window*/)
     }
 }
 
-void MainMenu::Render(sf::RenderWindow& window)
+void MainMenu::Render(Renderer& renderer)
 {
     // Draw the main background first (under mobile1/2 and buttons)
     if (s_mainBgLoaded) {
-        window.draw(s_mainBgSprite);
+        renderer.Draw(s_mainBgSprite);
     }
     else {
         // Fallback: white gradient background
-        window.draw(m_bgGradientTop);
-        window.draw(m_bgGradientBottom);
+        renderer.Draw(m_bgGradientTop);
+        renderer.Draw(m_bgGradientBottom);
     }
 
     // Then draw the mobile illustration
     if (m_mobileLoaded) {
-        window.draw(m_mobileSprite);
+        renderer.Draw(m_mobileSprite);
     }
 
     // Finally draw buttons
     for (auto& b : m_buttons) {
-        b.Draw(window);
+        b.Draw(renderer);
+    }
+
+    if (m_loadingProgress < 1.f) {
+        renderer.Draw(m_loadingTrack);
+        renderer.Draw(m_loadingBar);
+        renderer.Draw(m_loadingText.Text());
     }
 }
 
@@ -351,6 +395,9 @@ void MainMenu::OnMousePressed(const sf::Vector2f& mousePos)
     for (size_t i = 0; i < m_buttons.size(); ++i) {
         MenuButton& b = m_buttons[i];
         if (b.Contains(mousePos)) {
+            // Play waits for the background loader
+            if (i == 0 && m_loadingProgress < 1.f) break;
+
             // Local feedback
             b.Click();
 
@@ -395,8 +442,8 @@ void MainMenu::ResetMobileVisual()
     m_pendingAction = nullptr;
 
     if (m_mobileLoaded) {
-        m_mobileSprite.setTexture(m_mobileTex1, true);
-        const auto sz1 = m_mobileTex1.getSize();
+        m_mobileSprite.setTexture(*m_mobileTex1, true);
+        const auto sz1 = m_mobileTex1->getSize();
         m_mobileSprite.setOrigin(static_cast<float>(sz1.x) * 0.5f, static_cast<float>(sz1.y) * 0.5f);
         m_mobileSprite.setPosition(static_cast<float>(m_windowSize.x) * 0.5f, static_cast<float>(m_windowSize.y) * 0.5f);
         m_mobileSprite.setScale(1.f, 1.f);
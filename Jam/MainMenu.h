@@ -1,13 +1,16 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <functional>
+#include <memory>
 #include <vector>
+#include "Renderer.h"
+#include "RetainedText.h"
 
 class MenuButton {
 public:
     MenuButton(const sf::Font& font, const std::string& label, const sf::Vector2f& center, const sf::Vector2f& size);
 
-    void Draw(sf::RenderWindow& window);
+    void Draw(Renderer& renderer);
 
     // Per-frame update (replaces separate hover/press-only calls).
     // Pass dt and current mouse position.
@@ -32,17 +35,21 @@ public:
     // Control persistent visuals from MainMenu
     void SetPersistentAccent(bool enabled) { m_persistentAccent = enabled; }
     void SetExternalScaleTarget(float t) { m_externalScaleTarget = t; }
-    void RefreshLayout() { ApplyLayoutWithAnimation(); }
+    void RefreshLayout() { m_layoutDirty = true; }
 
 private:
-    void UpdateHover(const sf::Vector2f& mousePos, float dt);
+    bool UpdateHover(const sf::Vector2f& mousePos, float dt);
     void UpdatePress(float dt);
     void ApplyLayoutWithAnimation();
 
     sf::RectangleShape m_bg;
-    sf::Text m_text;
+    sf::RectangleShape m_glow;   // hover glow, shaped in ApplyLayoutWithAnimation
+    RetainedText m_text;
     sf::RectangleShape m_accent; // colored rect
 
+    // Set whenever an input of ApplyLayoutWithAnimation changed
+    bool m_layoutDirty{ true };
+
     sf::Vector2f m_baseCenter{};
     sf::Vector2f m_baseSize{};
     float m_accentBaseHeight{};
@@ -79,13 +86,16 @@ public:
     void BuildLayout();
 
     void Update(float dt, const sf::RenderWindow& window);
-    void Render(sf::RenderWindow& window);
+    void Render(Renderer& renderer);
 
     void OnMouseMoved(const sf::Vector2f& mousePos);
     void OnMousePressed(const sf::Vector2f& mousePos);
 
     void ResetMobileVisual();
 
+    // 0..1 while gameplay assets load; Play ignores clicks until it reaches 1
+    void SetLoadingProgress(float progress);
+
     // External actions
     std::function<void()> OnPlay;
     std::function<void()> OnOptions; // <-- NEW
@@ -103,8 +113,8 @@ private:
 
     // Mobile visual
     bool m_mobileLoaded{ false };
-    sf::Texture m_mobileTex1;
-    sf::Texture m_mobileTex2;
+    std::shared_ptr<const sf::Texture> m_mobileTex1;
+    std::shared_ptr<const sf::Texture> m_mobileTex2;
     sf::Sprite m_mobileSprite;
 
     bool m_mobilePressed{ false };
@@ -114,4 +124,10 @@ private:
 
     std::vector<MenuButton> m_buttons;
     sf::Vector2f m_mousePos{};
+
+    // Loading bar under the buttons
+    float m_loadingProgress{ 1.f };
+    sf::RectangleShape m_loadingTrack;
+    sf::RectangleShape m_loadingBar;
+    RetainedText m_loadingText;
 };
@@ -0,0 +1,160 @@
+#include "MixKernels.h"
+#include <algorithm>
+
+#ifdef JAM_MIX_SSE
+#include <emmintrin.h>
+#endif
+
+namespace {
+    constexpr float INT16_SCALE = 1.f / 32768.f;
+
+#ifdef JAM_MIX_SSE
+    // Eight 16-bit samples to two vectors of four floats
+    inline void widen(__m128i v, __m128& lo, __m128& hi)
+    {
+        lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+        hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+    }
+#endif
+}
+
+namespace MixKernels {
+
+void MonoToStereo(float* out, const sf::Int16* in, std::size_t frames,
+    float gainL, float gainR, float stepL, float stepR)
+{
+    gainL *= INT16_SCALE;
+    gainR *= INT16_SCALE;
+    stepL *= INT16_SCALE;
+    stepR *= INT16_SCALE;
+    std::size_t f = 0;
+
+#ifdef JAM_MIX_SSE
+    // Per-lane gains for frames f..f+3; the ramp advances four steps per vector
+    __m128 gl = _mm_add_ps(_mm_set1_ps(gainL), _mm_mul_ps(_mm_set1_ps(stepL), _mm_setr_ps(1.f, 2.f, 3.f, 4.f)));
+    __m128 gr = _mm_add_ps(_mm_set1_ps(gainR), _mm_mul_ps(_mm_set1_ps(stepR), _mm_setr_ps(1.f, 2.f, 3.f, 4.f)));
+    const __m128 dl = _mm_set1_ps(stepL * 4.f);
+    const __m128 dr = _mm_set1_ps(stepR * 4.f);
+
+    for (; f + 8 <= frames; f += 8) {
+        __m128 s0, s1;
+        widen(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + f)), s0, s1);
+        float* o = out + f * 2;
+
+        __m128 l = _mm_mul_ps(s0, gl);
+        __m128 r = _mm_mul_ps(s0, gr);
+        gl = _mm_add_ps(gl, dl);
+        gr = _mm_add_ps(gr, dr);
+        _mm_storeu_ps(o, _mm_add_ps(_mm_loadu_ps(o), _mm_unpacklo_ps(l, r)));
+        _mm_storeu_ps(o + 4, _mm_add_ps(_mm_loadu_ps(o + 4), _mm_unpackhi_ps(l, r)));
+
+        l = _mm_mul_ps(s1, gl);
+        r = _mm_mul_ps(s1, gr);
+        gl = _mm_add_ps(gl, dl);
+        gr = _mm_add_ps(gr, dr);
+        _mm_storeu_ps(o + 8, _mm_add_ps(_mm_loadu_ps(o + 8), _mm_unpacklo_ps(l, r)));
+        _mm_storeu_ps(o + 12, _mm_add_ps(_mm_loadu_ps(o + 12), _mm_unpackhi_ps(l, r)));
+    }
+#endif
+
+    for (; f < frames; ++f) {
+        const float gl1 = gainL + stepL * static_cast<float>(f + 1);
+        const float gr1 = gainR + stepR * static_cast<float>(f + 1);
+        const float s = static_cast<float>(in[f]);
+        out[f * 2] += s * gl1;
+        out[f * 2 + 1] += s * gr1;
+    }
+}
+
+void StereoToStereo(float* out, const sf::Int16* in, std::size_t frames,
+    float gainL, float gainR, float stepL, float stepR)
+{
+    gainL *= INT16_SCALE;
+    gainR *= INT16_SCALE;
+    stepL *= INT16_SCALE;
+    stepR *= INT16_SCALE;
+    std::size_t f = 0;
+
+#ifdef JAM_MIX_SSE
+    // Lanes are L R L R: two frames per vector
+    __m128 g = _mm_setr_ps(gainL + stepL, gainR + stepR, gainL + stepL * 2.f, gainR + stepR * 2.f);
+    const __m128 d = _mm_setr_ps(stepL * 2.f, stepR * 2.f, stepL * 2.f, stepR * 2.f);
+
+    for (; f + 4 <= frames; f += 4) {
+        __m128 s0, s1;
+        widen(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + f * 2)), s0, s1);
+        float* o = out + f * 2;
+        _mm_storeu_ps(o, _mm_add_ps(_mm_loadu_ps(o), _mm_mul_ps(s0, g)));
+        g = _mm_add_ps(g, d);
+        _mm_storeu_ps(o + 4, _mm_add_ps(_mm_loadu_ps(o + 4), _mm_mul_ps(s1, g)));
+        g = _mm_add_ps(g, d);
+    }
+#endif
+
+    for (; f < frames; ++f) {
+        out[f * 2] += static_cast<float>(in[f * 2]) * (gainL + stepL * static_cast<float>(f + 1));
+        out[f * 2 + 1] += static_cast<float>(in[f * 2 + 1]) * (gainR + stepR * static_cast<float>(f + 1));
+    }
+}
+
+std::size_t Resample(float* out, const sf::Int16* in, unsigned channels, std::size_t inFrames,
+    double& position, double step, bool loop, std::size_t frames,
+    float gainL, float gainR, float stepL, float stepR)
+{
+    if (inFrames == 0) return 0;
+    const double length = static_cast<double>(inFrames);
+    std::size_t f = 0;
+    for (; f < frames; ++f) {
+        if (position >= length) {
+            if (!loop) break;
+            position -= length * static_cast<double>(static_cast<std::size_t>(position / length));
+        }
+        const std::size_t i = static_cast<std::size_t>(position);
+        const float t = static_cast<float>(position - static_cast<double>(i));
+        // The sample after the last one is the first (looping) or silence
+        const std::size_t j = (i + 1 < inFrames) ? i + 1 : (loop ? 0 : i);
+        const float gl = (gainL + stepL * static_cast<float>(f + 1)) * INT16_SCALE;
+        const float gr = (gainR + stepR * static_cast<float>(f + 1)) * INT16_SCALE;
+
+        if (channels == 1) {
+            const float a = static_cast<float>(in[i]);
+            const float s = a + (static_cast<float>(in[j]) - a) * t;
+            out[f * 2] += s * gl;
+            out[f * 2 + 1] += s * gr;
+        }
+        else {
+            const float l = static_cast<float>(in[i * channels]);
+            const float r = static_cast<float>(in[i * channels + 1]);
+            out[f * 2] += (l + (static_cast<float>(in[j * channels]) - l) * t) * gl;
+            out[f * 2 + 1] += (r + (static_cast<float>(in[j * channels + 1]) - r) * t) * gr;
+        }
+        position += step;
+    }
+    return f;
+}
+
+void FloatToInt16(sf::Int16* out, const float* in, std::size_t count)
+{
+    std::size_t i = 0;
+
+#ifdef JAM_MIX_SSE
+    const __m128 scale = _mm_set1_ps(32767.f);
+    const __m128 lo = _mm_set1_ps(-1.f);
+    const __m128 hi = _mm_set1_ps(1.f);
+    for (; i + 8 <= count; i += 8) {
+        // Clamped first: cvtps turns anything past int range into INT_MIN
+        const __m128 x = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i), lo), hi);
+        const __m128 y = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i + 4), lo), hi);
+        const __m128i a = _mm_cvtps_epi32(_mm_mul_ps(x, scale));
+        const __m128i b = _mm_cvtps_epi32(_mm_mul_ps(y, scale));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(a, b));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const float v = std::clamp(in[i], -1.f, 1.f) * 32767.f;
+        out[i] = static_cast<sf::Int16>(v < 0.f ? v - 0.5f : v + 0.5f);
+    }
+}
+
+}
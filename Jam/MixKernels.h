@@ -0,0 +1,30 @@
+#pragma once
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+// SSE2 is baseline on x64; 32-bit builds without it get the scalar loops
+#if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define JAM_MIX_SSE 1
+#endif
+
+// Inner loops of SoftwareMixer. `out` is an interleaved stereo float
+// accumulator (full scale = 1); gains ramp linearly, advancing by
+// stepL/stepR per frame, so a block's gain change has no zipper noise.
+// Uses SSE2 where available.
+namespace MixKernels {
+    // Source frames played 1:1
+    void MonoToStereo(float* out, const sf::Int16* in, std::size_t frames,
+        float gainL, float gainR, float stepL, float stepR);
+    void StereoToStereo(float* out, const sf::Int16* in, std::size_t frames,
+        float gainL, float gainR, float stepL, float stepR);
+
+    // Pitch or sample-rate change: linear interpolation, `step` source frames
+    // per output frame from `position` (advanced). Stops at the end of the
+    // source unless `loop`; returns the frames written.
+    std::size_t Resample(float* out, const sf::Int16* in, unsigned channels, std::size_t inFrames,
+        double& position, double step, bool loop, std::size_t frames,
+        float gainL, float gainR, float stepL, float stepR);
+
+    // Saturating float -> 16-bit conversion
+    void FloatToInt16(sf::Int16* out, const float* in, std::size_t count);
+}
@@ -1,4 +1,5 @@
 #include "OptionsUI.h"
+#include "ResourceCache.h"
 #include <algorithm>
 
 namespace OptionsUI {
@@ -60,16 +61,19 @@ namespace OptionsUI {
 		sl.valueText.setString(std::to_string(percent) + "%");
 	}
 
-	void Show(AudioManager& audio, const sf::Font& font, MainMenu* menu) {
+	void Show(AudioManager& audio, const sf::Font& font, MainMenu* menu, Renderer& renderer) {
 		const auto desktop = sf::VideoMode::getDesktopMode();
 		sf::RenderWindow opts(desktop, "Options", sf::Style::Fullscreen);
 		opts.setFramerateLimit(60);
 
-		sf::Texture controlsTex;
-		controlsTex.loadFromFile("Assets/MainMenu/Controls.png");
-		sf::Sprite controlsSprite(controlsTex);
+		sf::RenderTarget& previousTarget = renderer.Target();
+		renderer.SetTarget(opts);
+
+		std::shared_ptr<const sf::Texture> controlsTex = ResourceCache::Shared().GetTexture("Assets/MainMenu/Controls.png");
+		if (!controlsTex) controlsTex = std::make_shared<const sf::Texture>();
+		sf::Sprite controlsSprite(*controlsTex);
 		float maxWidth = desktop.width * 0.5f;
-		float scale = maxWidth / controlsTex.getSize().x;
+		float scale = maxWidth / controlsTex->getSize().x;
 		controlsSprite.setScale(scale, scale);
 		controlsSprite.setPosition(
 			desktop.width * 0.5f - controlsSprite.getGlobalBounds().width * 0.5f,
@@ -155,20 +159,24 @@ namespace OptionsUI {
 				fadeOverlay.setFillColor(sf::Color(0, 0, 0, alpha));
 				if (t >= 1.f) { opts.close(); break; }
 			}
-			opts.clear(sf::Color(30, 30, 40));
-			opts.draw(moveText);
-			opts.draw(hintText);
-			opts.draw(controlsSprite);
+			renderer.BeginFrame();
+			renderer.BeginPass(RenderPass::UI);
+			renderer.Clear(sf::Color(30, 30, 40));
+			renderer.Draw(moveText);
+			renderer.Draw(hintText);
+			renderer.Draw(controlsSprite);
 			for (auto& s : sliders) {
-				opts.draw(s.labelText);
-				opts.draw(s.valueText);
-				opts.draw(s.bar);
-				opts.draw(s.fill);
-				opts.draw(s.knob);
+				renderer.Draw(s.labelText);
+				renderer.Draw(s.valueText);
+				renderer.Draw(s.bar);
+				renderer.Draw(s.fill);
+				renderer.Draw(s.knob);
 			}
-			if (exiting) opts.draw(fadeOverlay);
+			if (exiting) renderer.Draw(fadeOverlay);
+			renderer.EndFrame();
 			opts.display();
 		}
+		renderer.SetTarget(previousTarget);
 		if (menu) menu->ResetMobileVisual();
 	}
 
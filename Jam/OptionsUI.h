@@ -2,7 +2,9 @@
 #include <SFML/Graphics.hpp>
 #include "AudioManager.h"
 #include "MainMenu.h"
+#include "Renderer.h"
 
 namespace OptionsUI {
- void Show(AudioManager& audio, const sf::Font& font, MainMenu* menu);
+ // Runs its own modal window; draws through `renderer` so stats keep accumulating
+ void Show(AudioManager& audio, const sf::Font& font, MainMenu* menu, Renderer& renderer);
 }
@@ -0,0 +1,107 @@
+#include "ParallaxTiles.h"
+#include <algorithm>
+#include <cmath>
+
+void ParallaxTileSet::Build(const sf::Image& image)
+{
+    m_tiles.clear();
+    m_opaqueCount = 0;
+    m_emptyCount = 0;
+    m_imageSize = image.getSize();
+    m_bounds = sf::IntRect();
+
+    const int w = static_cast<int>(m_imageSize.x);
+    const int h = static_cast<int>(m_imageSize.y);
+    if (w == 0 || h == 0) return;
+
+    const sf::Uint8* px = image.getPixelsPtr();
+    int layerMinX = w, layerMinY = h, layerMaxX = -1, layerMaxY = -1;
+
+    for (int ty = 0; ty < h; ty += TILE_SIZE) {
+        for (int tx = 0; tx < w; tx += TILE_SIZE) {
+            const int tw = std::min(TILE_SIZE, w - tx);
+            const int th = std::min(TILE_SIZE, h - ty);
+
+            int minX = tx + tw, minY = ty + th, maxX = -1, maxY = -1;
+            bool opaque = true;
+
+            for (int y = ty; y < ty + th; ++y) {
+                const sf::Uint8* row = px + (static_cast<std::size_t>(y) * w + tx) * 4 + 3; // alpha channel
+                for (int x = 0; x < tw; ++x) {
+                    const sf::Uint8 a = row[x * 4];
+                    if (a != 255) opaque = false;
+                    if (a != 0) {
+                        minX = std::min(minX, tx + x);
+                        maxX = std::max(maxX, tx + x);
+                        minY = std::min(minY, y);
+                        maxY = std::max(maxY, y);
+                    }
+                }
+            }
+
+            if (maxX < 0) {
+                ++m_emptyCount;
+                continue;
+            }
+
+            ParallaxTile tile;
+            tile.opaque = opaque;
+            tile.rect = opaque ? sf::IntRect(tx, ty, tw, th)
+                : sf::IntRect(minX, minY, maxX - minX + 1, maxY - minY + 1);
+            if (opaque) ++m_opaqueCount;
+            m_tiles.push_back(tile);
+
+            layerMinX = std::min(layerMinX, tile.rect.left);
+            layerMinY = std::min(layerMinY, tile.rect.top);
+            layerMaxX = std::max(layerMaxX, tile.rect.left + tile.rect.width);
+            layerMaxY = std::max(layerMaxY, tile.rect.top + tile.rect.height);
+        }
+    }
+
+    if (layerMaxX > layerMinX)
+        m_bounds = sf::IntRect(layerMinX, layerMinY, layerMaxX - layerMinX, layerMaxY - layerMinY);
+}
+
+void CoverageGrid::Reset(const sf::FloatRect& area, float cellSize)
+{
+    m_area = area;
+    m_cell = std::max(1.f, cellSize);
+    m_cols = std::max(1, static_cast<int>(std::ceil(area.width / m_cell)));
+    m_rows = std::max(1, static_cast<int>(std::ceil(area.height / m_cell)));
+    m_covered.assign(static_cast<std::size_t>(m_cols) * m_rows, 0);
+}
+
+void CoverageGrid::AddOccluder(const sf::FloatRect& rect)
+{
+    // Only cells completely inside the occluder
+    int x0 = static_cast<int>(std::ceil((rect.left - m_area.left) / m_cell));
+    int y0 = static_cast<int>(std::ceil((rect.top - m_area.top) / m_cell));
+    int x1 = static_cast<int>(std::floor((rect.left + rect.width - m_area.left) / m_cell));
+    int y1 = static_cast<int>(std::floor((rect.top + rect.height - m_area.top) / m_cell));
+    x0 = std::max(x0, 0); y0 = std::max(y0, 0);
+    x1 = std::min(x1, m_cols); y1 = std::min(y1, m_rows);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    for (int y = y0; y < y1; ++y)
+        std::fill(m_covered.begin() + static_cast<std::size_t>(y) * m_cols + x0,
+            m_covered.begin() + static_cast<std::size_t>(y) * m_cols + x1, 1);
+}
+
+bool CoverageGrid::IsHidden(const sf::FloatRect& rect) const
+{
+    // Every cell the rect touches (clipped to the visible area) must be covered
+    int x0 = static_cast<int>(std::floor((rect.left - m_area.left) / m_cell));
+    int y0 = static_cast<int>(std::floor((rect.top - m_area.top) / m_cell));
+    int x1 = static_cast<int>(std::ceil((rect.left + rect.width - m_area.left) / m_cell));
+    int y1 = static_cast<int>(std::ceil((rect.top + rect.height - m_area.top) / m_cell));
+    x0 = std::max(x0, 0); y0 = std::max(y0, 0);
+    x1 = std::min(x1, m_cols); y1 = std::min(y1, m_rows);
+    if (x0 >= x1 || y0 >= y1) return true; // entirely outside the visible area
+
+    for (int y = y0; y < y1; ++y) {
+        const unsigned char* row = m_covered.data() + static_cast<std::size_t>(y) * m_cols;
+        for (int x = x0; x < x1; ++x)
+            if (!row[x]) return false;
+    }
+    return true;
+}
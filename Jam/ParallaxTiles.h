@@ -0,0 +1,52 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Load-time alpha analysis of a parallax layer image.
+// The image is cut into a fixed grid; fully transparent cells are dropped,
+// fully opaque cells are kept whole and everything else is trimmed to the
+// tight bounds of its visible pixels.
+struct ParallaxTile {
+    sf::IntRect rect;   // texture pixels
+    bool opaque = false;
+};
+
+class ParallaxTileSet {
+public:
+    static constexpr int TILE_SIZE = 120; // divides 1920x1080 evenly
+
+    void Build(const sf::Image& image);
+
+    const std::vector<ParallaxTile>& Tiles() const { return m_tiles; }
+    const sf::IntRect& Bounds() const { return m_bounds; } // trimmed bounds of the whole layer
+    sf::Vector2u ImageSize() const { return m_imageSize; }
+
+    std::size_t OpaqueCount() const { return m_opaqueCount; }
+    std::size_t TranslucentCount() const { return m_tiles.size() - m_opaqueCount; }
+    std::size_t EmptyCount() const { return m_emptyCount; }
+
+private:
+    std::vector<ParallaxTile> m_tiles;
+    sf::IntRect m_bounds;
+    sf::Vector2u m_imageSize{ 0, 0 };
+    std::size_t m_opaqueCount = 0;
+    std::size_t m_emptyCount = 0;
+};
+
+// Coarse coverage mask over the visible area, filled front-to-back with
+// opaque tiles so tiles further back can be skipped when fully hidden.
+// A cell only counts as covered when it lies entirely inside one occluder,
+// so the test is conservative.
+class CoverageGrid {
+public:
+    void Reset(const sf::FloatRect& area, float cellSize);
+    void AddOccluder(const sf::FloatRect& rect);
+    bool IsHidden(const sf::FloatRect& rect) const;
+
+private:
+    sf::FloatRect m_area;
+    float m_cell = 1.f;
+    int m_cols = 0;
+    int m_rows = 0;
+    std::vector<unsigned char> m_covered;
+};
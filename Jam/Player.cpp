@@ -2,6 +2,9 @@
 #include "World.h"
 #include "Game.h"
 #include "Units.h"
+#include "AsyncLoader.h"
+#include "TextureBaker.h"
+#include <iterator>
 #include <sstream>
 #include <iostream>
 
@@ -73,6 +76,82 @@ static void CreateFixturesFromSpriteBounds(b2Body* body, b2Fixture*& footFixture
     footFixture = body->CreateFixture(&footFixtureDef);
 }
 
+// ------------------------------------------------------------
+//  CLIP TABLES
+// ------------------------------------------------------------
+struct PlayerClipDef {
+    PlayerClip clip;
+    const char* name;
+    const char* path;   // numbered prefix ("<path>1.png".."<path>N.png"), or a single file when frameCount == 0
+    int frameCount;
+    float frameTime;
+    bool loop;
+};
+
+// Frames are baked down to this on-screen scale (see TextureBaker)
+static constexpr float kPlayerDrawScale = 0.33f;
+
+static constexpr PlayerClipDef kPlayerClips[] = {
+    { PlayerClip::Run,       "Run",       "Assets/Player/Run/Run",          8, 0.08f, true  },
+    { PlayerClip::Walk,      "Walk",      "Assets/Player/Walk/Walk",        7, 0.10f, true  },
+    { PlayerClip::Idle,      "Idle",      "Assets/Player/Run/Idle.png",     0, 0.20f, true  },
+    { PlayerClip::Jump,      "Jump",      "Assets/Player/Jump/",            6, 0.10f, false },
+    // Angry variants are kept available (no color trigger), selected from the audio state
+    { PlayerClip::AngryWalk, "AngryWalk", "Assets/Player/Angry walk/",      7, 0.10f, true  },
+    { PlayerClip::AngryRun,  "AngryRun",  "Assets/Player/Angry run/",       8, 0.08f, true  },
+    { PlayerClip::AngryJump, "AngryJump", "Assets/Player/Angry jump/",      3, 0.10f, false },
+    { PlayerClip::AngryIdle, "AngryIdle", "Assets/Player/Angry walk/Q.png", 0, 0.20f, true  },
+    // Wave (played once during input lock)
+    { PlayerClip::Wave,      "Wave",      "Assets/Player/Wave/",            5, 0.12f, false },
+};
+static_assert(std::size(kPlayerClips) == static_cast<std::size_t>(PlayerClip::Count), "every PlayerClip needs a definition");
+
+// PrepareClip indexes the table by PlayerClip, so rows must stay in enum order
+static constexpr bool clipsInEnumOrder()
+{
+    for (std::size_t i = 0; i < std::size(kPlayerClips); ++i)
+        if (kPlayerClips[i].clip != static_cast<PlayerClip>(i)) return false;
+    return true;
+}
+static_assert(clipsInEnumOrder(), "kPlayerClips rows must follow PlayerClip order");
+
+// Locomotion clip by [psycho][airborne, idle, walk, run]
+enum { MOVE_AIR, MOVE_IDLE, MOVE_WALK, MOVE_RUN, MOVE_COUNT };
+static constexpr PlayerClip kMoveClips[2][MOVE_COUNT] = {
+    { PlayerClip::Jump,      PlayerClip::Idle,      PlayerClip::Walk,      PlayerClip::Run },
+    { PlayerClip::AngryJump, PlayerClip::AngryIdle, PlayerClip::AngryWalk, PlayerClip::AngryRun },
+};
+
+static std::vector<std::string> clipFramePaths(const PlayerClipDef& def)
+{
+    std::vector<std::string> paths;
+    if (def.frameCount == 0) {
+        paths.push_back(def.path);
+    }
+    else {
+        for (int i = 1; i <= def.frameCount; i++)
+            paths.push_back(def.path + std::to_string(i) + ".png");
+    }
+    return paths;
+}
+
+void Player::QueueAssets(AsyncLoader& loader)
+{
+    // Frames are packed into sheet pages when the clips are built, so only decode them here
+    for (const PlayerClipDef& def : kPlayerClips) {
+        for (const std::string& path : clipFramePaths(def))
+            loader.QueueImage(path, TextureBaker::Shared().BakeScale(kPlayerDrawScale));
+    }
+}
+
+bool Player::PrepareClip(PlayerClip clip)
+{
+    // Same arguments as the constructor's AddClip, so it finds the clip cached
+    const PlayerClipDef& def = kPlayerClips[static_cast<std::size_t>(clip)];
+    return ClipLibrary::Shared().Load(clipFramePaths(def), def.frameTime, def.loop,
+        TextureBaker::Shared().BakeScale(kPlayerDrawScale)) != nullptr;
+}
+
 // ------------------------------------------------------------
 //  CONSTRUCTOR
 // ------------------------------------------------------------
@@ -93,82 +172,25 @@ Player::Player(b2World* world, float startX, float startY)
     m_body = m_world->CreateBody(&boxDef);
 
     m_anim.BindSprite(&m_sprite);
-    m_sprite.setScale(0.33f, 0.33f);
+    const float spriteScale = TextureBaker::Shared().SpriteScale(kPlayerDrawScale);
+    m_sprite.setScale(spriteScale, spriteScale);
 
     // -----------------------------------------------------
-    //        NORMAL ANIMATIONS (sprite only, no tint)
+    //        ANIMATIONS (sprite only, no tint)
     // -----------------------------------------------------
-
-    // Run
-    {
-        std::vector<std::string> paths;
-        const std::string base = "Assets/Player/Run/";
-        for (int i = 1; i <= 8; i++)
-            paths.push_back(base + "Run" + std::to_string(i) + ".png");
-        m_anim.AddClip("Run", paths, 0.08f, true);
-    }
-
-    // Walk
-    {
-        std::vector<std::string> paths;
-        const std::string base = "Assets/Player/Walk/";
-        for (int i = 1; i <= 7; i++)
-            paths.push_back(base + "Walk" + std::to_string(i) + ".png");
-        m_anim.AddClip("Walk", paths, 0.10f, true);
-    }
-
-    // Idle
-    {
-        std::vector<std::string> paths = { "Assets/Player/Run/Idle.png" };
-        m_anim.AddClip("Idle", paths, 0.2f, true);
-    }
-
-    // Jump
-    {
-        std::vector<std::string> paths;
-        const std::string base = "Assets/Player/Jump/";
-        for (int i = 1; i <= 6; i++)
-            paths.push_back(base + std::to_string(i) + ".png");
-        m_anim.AddClip("Jump", paths, 0.10f, false);
-    }
-    
-
-    // Angry variants are kept available (no color trigger), use programmatic state if needed
-    {
-        std::vector<std::string> paths;
-        const std::string base = "Assets/Player/Angry walk/";
-        for (int i = 1; i <= 7; i++)
-            paths.push_back(base + std::to_string(i) + ".png");
-        m_anim.AddClip("AngryWalk", paths, 0.10f, true);
-    }
-    {
-        std::vector<std::string> paths;
-        const std::string base = "Assets/Player/Angry run/";
-        for (int i = 1; i <= 8; i++)
-            paths.push_back(base + std::to_string(i) + ".png");
-        m_anim.AddClip("AngryRun", paths, 0.08f, true);
-    }
-    {
-        std::vector<std::string> paths;
-        const std::string base = "Assets/Player/Angry jump/";
-        for (int i = 1; i <= 3; i++)
-            paths.push_back(base + std::to_string(i) + ".png");
-        m_anim.AddClip("AngryJump", paths, 0.10f, false);
-    }
-    {
-        std::vector<std::string> paths = { "Assets/Player/Angry walk/Q.png" };
-        m_anim.AddClip("AngryIdle", paths, 0.2f, true);
-    }
-
-    // Wave (played once during input lock)
-    {
-        std::vector<std::string> paths;
-        const std::string base = "Assets/Player/Wave/";
-        for (int i = 1; i <= 5; i++)
-            paths.push_back(base + std::to_string(i) + ".png");
-        m_anim.AddClip("Wave", paths, 0.12f, false);   // <-- NOT looping
+    // Ids are resolved once here; Update only ever indexes m_clipIds
+    m_clipIds.fill(Animation::INVALID_CLIP);
+    for (const PlayerClipDef& def : kPlayerClips) {
+        const Animation::ClipId id = m_anim.AddClip(def.name, clipFramePaths(def), def.frameTime, def.loop,
+            TextureBaker::Shared().BakeScale(kPlayerDrawScale));
+        if (id == Animation::INVALID_CLIP)
+            std::cerr << "Warning: failed to load player clip " << def.name << "\n";
+        m_clipIds[static_cast<std::size_t>(def.clip)] = id;
     }
-    m_anim.SetClip("Idle", true);
+    m_anim.SetFinishedCallback(m_clipIds[static_cast<std::size_t>(PlayerClip::Wave)], [this]() {
+        m_playingWave = false;
+    });
+    setClip(PlayerClip::Idle);
     m_anim.SetFacingRight(true);
 
     // Ensure no tint is applied; use sprite’s original texture colors
@@ -206,57 +228,26 @@ void Player::Update(float dt, bool grounded)
 
     const bool isMoving = std::abs(vel.x) > 0.05f;
 
-    // Choose animation WITHOUT color-based psycho detection
-    std::string desired;
-
     // If you still want to use audio state to drive "angry" look, you can use m_audioState.
     const bool psycho = (m_audioState == PlayerAudioState::Crazy);
 
     if (m_playingWave)
     {
-        int currentFrame = m_anim.CurrentFrameIndex();
-
-        // Detect when animation freezes at last frame
-        if (currentFrame == m_lastWaveFrame)
-            m_waveTimer += dt;
-        else
-            m_waveTimer = 0.f; // reset because still animating
-
-        m_lastWaveFrame = currentFrame;
-
-        // If non-looping clip stops changing frames → finished
-        if (m_waveTimer > 0.15f)
-        {
-            m_playingWave = false;
-            // DO NOT return, fall through to normal state logic
-        }
-        else
-        {
-            // Still playing wave animation
-            m_anim.Update(dt);
-            return;
-        }
+        // Still playing wave animation; normal state logic resumes once it finishes
+        m_anim.Update(dt);
+        return;
     }
 
-    if (!grounded)
-    {
-        desired = psycho ? "AngryJump" : "Jump";
-    }
-    else
-    {
-        if (!isMoving)
-            desired = psycho ? "AngryIdle" : "Idle";
-        else
-            desired = psycho ? (m_isWalking ? "AngryWalk" : "AngryRun")
-            : (m_isWalking ? "Walk" : "Run");
-    }
+    // Choose animation WITHOUT color-based psycho detection
+    const int move = !grounded ? MOVE_AIR
+        : !isMoving ? MOVE_IDLE
+        : m_isWalking ? MOVE_WALK : MOVE_RUN;
+    const PlayerClip desired = kMoveClips[psycho ? 1 : 0][move];
 
-    if (m_anim.CurrentClip() != desired)
+    if (m_currentClip != desired)
     {
-        m_anim.SetClip(desired, true);
-
-        if (desired == "Jump" || desired == "AngryJump")
-            m_anim.Reset();
+        // SetClip resets the frame, so jumps always start from their first frame
+        setClip(desired);
 
        // CreateFixturesFromSpriteBounds(m_body, m_footFixture, m_sprite);
     }
@@ -278,22 +269,28 @@ void Player::SyncGraphics()
 
 void Player::PlayWave()
 {
+    // Without the clip nothing would ever clear m_playingWave
+    if (m_clipIds[static_cast<std::size_t>(PlayerClip::Wave)] == Animation::INVALID_CLIP) return;
+
     if (!m_playingWave)
     {
         m_playingWave = true;
-        m_waveTimer = 0.f;
-        m_lastWaveFrame = -1;
 
-        m_anim.SetClip("Wave", true);
-        m_anim.Reset();
+        setClip(PlayerClip::Wave);
     }
 }
 
+void Player::setClip(PlayerClip clip)
+{
+    m_currentClip = clip;
+    m_anim.SetClip(m_clipIds[static_cast<std::size_t>(clip)], true);
+}
+
 // ------------------------------------------------------------
-void Player::Draw(RenderWindow& window)
+void Player::Draw(Renderer& renderer)
 {
     SyncGraphics();
-    window.draw(m_sprite);
+    renderer.Draw(m_sprite);
 }
 
 // ------------------------------------------------------------
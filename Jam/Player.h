@@ -1,20 +1,37 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
+#include <array>
+#include <cstdint>
 #include "Animation.h"
+#include "Renderer.h"
+
+class AsyncLoader;
 
 enum class PlayerAudioState { Neutral, Crazy };
 
+// Every clip the player owns; doubles as the index into its clip tables
+enum class PlayerClip : std::uint8_t {
+    Run, Walk, Idle, Jump,
+    AngryWalk, AngryRun, AngryJump, AngryIdle,
+    Wave,
+    Count
+};
+
 class Player {
 public:
-    bool m_playingWave = false;
-    float m_waveTimer = 0.f;
-    int m_lastWaveFrame = -1;
+    bool m_playingWave = false; // cleared by the Wave clip's finished callback
 
     // Construct player and create physics body + fixtures in the provided world
     Player(b2World* world, float startX = 640.f, float startY = 200.f);
     ~Player();
 
+    // Queue the animation frames for background decoding before construction
+    static void QueueAssets(AsyncLoader& loader);
+    // Pack one clip's sheet pages into ClipLibrary ahead of construction, so
+    // loading can spread the uploads over several frames. False if it failed.
+    static bool PrepareClip(PlayerClip clip);
+
     // update logic (physics already stepped by Game/Level)
     void Update(float dt, bool grounded);
 
@@ -22,7 +39,7 @@ public:
     void SyncGraphics();
 
     // draw the player sprite
-    void Draw(sf::RenderWindow& window);
+    void Draw(Renderer& renderer);
 
     void PlayWave();
     // physics accessors
@@ -59,6 +76,7 @@ public:
 
 private:
     void applyCollisionFromSprite();
+    void setClip(PlayerClip clip);
 
 private:
     b2World* m_world;
@@ -68,6 +86,8 @@ private:
     // Visuals
     sf::Sprite m_sprite;
     Animation m_anim;
+    std::array<Animation::ClipId, static_cast<std::size_t>(PlayerClip::Count)> m_clipIds{};
+    PlayerClip m_currentClip = PlayerClip::Count;
 
     // State
     bool m_facingRight;
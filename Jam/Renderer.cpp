@@ -0,0 +1,205 @@
+#include "Renderer.h"
+#include <algorithm>
+#include <sstream>
+#include <iostream>
+
+Renderer::Renderer(sf::RenderTarget& target)
+    : m_target(&target)
+{
+}
+
+Renderer::~Renderer()
+{
+    StopCsv();
+}
+
+void Renderer::SetTarget(sf::RenderTarget& target)
+{
+    if (m_target == &target) return;
+    m_target = &target;
+    // A new target has its own GL state cache, so the next draw rebinds everything
+    m_hasLast = false;
+}
+
+void Renderer::BeginFrame()
+{
+    for (auto& p : m_passes) p.Reset();
+    m_hasLast = false;
+    m_pass = RenderPass::UI;
+}
+
+void Renderer::EndFrame()
+{
+    m_lastPasses = m_passes;
+    m_lastFrame.Reset();
+    for (const auto& p : m_passes) m_lastFrame += p;
+
+    if (m_csv.is_open()) writeCsvFrame();
+    ++m_frameIndex;
+}
+
+void Renderer::BeginPass(RenderPass pass)
+{
+    m_pass = pass;
+}
+
+void Renderer::Clear(const sf::Color& color)
+{
+    m_target->clear(color);
+}
+
+void Renderer::SetView(const sf::View& view)
+{
+    m_target->setView(view);
+    m_passes[static_cast<std::size_t>(m_pass)].stateChanges++;
+}
+
+void Renderer::Draw(const sf::Sprite& sprite, const sf::RenderStates& states)
+{
+    m_target->draw(sprite, states);
+    record(sprite.getTexture(), states, 4); // one triangle strip quad
+}
+
+void Renderer::Draw(const sf::Shape& shape, const sf::RenderStates& states)
+{
+    m_target->draw(shape, states);
+
+    // Fill is a triangle fan: center + points + closing point
+    const std::size_t points = shape.getPointCount();
+    record(shape.getTexture(), states, points + 2);
+
+    // Outline is a separate, untextured triangle strip
+    if (shape.getOutlineThickness() != 0.f)
+        record(nullptr, states, (points + 1) * 2);
+}
+
+void Renderer::Draw(const sf::Text& text, const sf::RenderStates& states)
+{
+    m_target->draw(text, states);
+
+    const sf::Font* font = text.getFont();
+    if (!font) return;
+
+    // Six vertices (two triangles) per visible glyph
+    std::size_t glyphs = 0;
+    for (sf::Uint32 c : text.getString()) {
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\v') ++glyphs;
+    }
+    const sf::Texture* page = &font->getTexture(text.getCharacterSize());
+
+    if (text.getOutlineThickness() != 0.f)
+        record(page, states, glyphs * 6);
+    record(page, states, glyphs * 6);
+}
+
+void Renderer::Draw(const sf::VertexArray& vertices, const sf::RenderStates& states)
+{
+    if (vertices.getVertexCount() == 0) return;
+    m_target->draw(vertices, states);
+    record(states.texture, states, vertices.getVertexCount());
+}
+
+void Renderer::Draw(const sf::VertexBuffer& buffer, const sf::RenderStates& states)
+{
+    if (buffer.getVertexCount() == 0) return;
+    m_target->draw(buffer, states);
+    record(states.texture, states, buffer.getVertexCount());
+}
+
+void Renderer::Draw(const sf::VertexBuffer& buffer, std::size_t firstVertex, std::size_t vertexCount, const sf::RenderStates& states)
+{
+    if (vertexCount == 0 || firstVertex >= buffer.getVertexCount()) return;
+    vertexCount = std::min(vertexCount, buffer.getVertexCount() - firstVertex);
+    m_target->draw(buffer, firstVertex, vertexCount, states);
+    record(states.texture, states, vertexCount);
+}
+
+void Renderer::Draw(const sf::Vertex* vertices, std::size_t count, sf::PrimitiveType type, const sf::RenderStates& states)
+{
+    if (!vertices || count == 0) return;
+    m_target->draw(vertices, count, type, states);
+    record(states.texture, states, count);
+}
+
+void Renderer::Draw(const sf::Drawable& drawable, const sf::RenderStates& states)
+{
+    m_target->draw(drawable, states);
+    record(states.texture, states, 0);
+}
+
+void Renderer::record(const sf::Texture* texture, const sf::RenderStates& states, std::size_t vertexCount)
+{
+    RenderCounters& c = m_passes[static_cast<std::size_t>(m_pass)];
+    c.drawCalls++;
+    c.vertices += vertexCount;
+
+    if (!m_hasLast || texture != m_lastTexture) {
+        c.textureBinds++;
+        m_lastTexture = texture;
+    }
+    if (!m_hasLast || states.blendMode != m_lastBlend || states.shader != m_lastShader) {
+        c.stateChanges++;
+        m_lastBlend = states.blendMode;
+        m_lastShader = states.shader;
+    }
+    m_hasLast = true;
+}
+
+const char* Renderer::PassName(RenderPass pass)
+{
+    switch (pass) {
+    case RenderPass::Background: return "background";
+    case RenderPass::Obstacles: return "obstacles";
+    case RenderPass::Player: return "player";
+    case RenderPass::Foreground: return "foreground";
+    case RenderPass::UI: return "ui";
+    default: return "unknown";
+    }
+}
+
+std::string Renderer::Summary() const
+{
+    std::ostringstream ss;
+    ss << "Frame " << m_frameIndex
+        << "  draws " << m_lastFrame.drawCalls
+        << "  tex " << m_lastFrame.textureBinds
+        << "  verts " << m_lastFrame.vertices
+        << "  states " << m_lastFrame.stateChanges << "\n";
+    for (std::size_t i = 0; i < m_lastPasses.size(); ++i) {
+        const RenderCounters& c = m_lastPasses[i];
+        ss << "  " << PassName(static_cast<RenderPass>(i)) << ": "
+            << c.drawCalls << " / " << c.textureBinds << " / "
+            << c.vertices << " / " << c.stateChanges << "\n";
+    }
+    if (m_csv.is_open()) ss << "  [CSV recording]\n";
+    return ss.str();
+}
+
+bool Renderer::StartCsv(const std::string& path)
+{
+    StopCsv();
+    m_csv.open(path, std::ios::out | std::ios::trunc);
+    if (!m_csv.is_open()) {
+        std::cerr << "Failed to open render stats CSV: " << path << std::endl;
+        return false;
+    }
+    m_csv << "frame,pass,draw_calls,texture_binds,vertices,state_changes\n";
+    return true;
+}
+
+void Renderer::StopCsv()
+{
+    if (m_csv.is_open()) m_csv.close();
+}
+
+void Renderer::writeCsvFrame()
+{
+    for (std::size_t i = 0; i < m_lastPasses.size(); ++i) {
+        const RenderCounters& c = m_lastPasses[i];
+        m_csv << m_frameIndex << ',' << PassName(static_cast<RenderPass>(i)) << ','
+            << c.drawCalls << ',' << c.textureBinds << ',' << c.vertices << ',' << c.stateChanges << '\n';
+    }
+    m_csv << m_frameIndex << ",total,"
+        << m_lastFrame.drawCalls << ',' << m_lastFrame.textureBinds << ','
+        << m_lastFrame.vertices << ',' << m_lastFrame.stateChanges << '\n';
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+// Named passes used to bucket render statistics.
+enum class RenderPass { Background, Obstacles, Player, Foreground, UI, Count };
+
+// Counters for a single pass or a whole frame.
+struct RenderCounters {
+    std::size_t drawCalls = 0;
+    std::size_t textureBinds = 0;   // texture differs from the previous draw
+    std::size_t vertices = 0;
+    std::size_t stateChanges = 0;   // blend mode / shader / view changes
+
+    void Reset() { *this = RenderCounters(); }
+    RenderCounters& operator+=(const RenderCounters& o) {
+        drawCalls += o.drawCalls;
+        textureBinds += o.textureBinds;
+        vertices += o.vertices;
+        stateChanges += o.stateChanges;
+        return *this;
+    }
+};
+
+// Thin wrapper around sf::RenderTarget that forwards every draw and counts
+// what it costs. Counts are kept per frame and per RenderPass; the last
+// completed frame is available for an overlay and can be streamed to CSV.
+class Renderer {
+public:
+    explicit Renderer(sf::RenderTarget& target);
+    ~Renderer();
+
+    // Redirect drawing to another target (e.g. an off-screen texture or a second window)
+    void SetTarget(sf::RenderTarget& target);
+    sf::RenderTarget& Target() { return *m_target; }
+
+    // Frame / pass bookkeeping
+    void BeginFrame();
+    void EndFrame();
+    void BeginPass(RenderPass pass);
+    RenderPass CurrentPass() const { return m_pass; }
+
+    // Forwarded target state
+    void Clear(const sf::Color& color = sf::Color::Black);
+    void SetView(const sf::View& view);
+    const sf::View& GetView() const { return m_target->getView(); }
+    const sf::View& GetDefaultView() const { return m_target->getDefaultView(); }
+    sf::Vector2u GetSize() const { return m_target->getSize(); }
+
+    // Counted draws
+    void Draw(const sf::Sprite& sprite, const sf::RenderStates& states = sf::RenderStates::Default);
+    void Draw(const sf::Shape& shape, const sf::RenderStates& states = sf::RenderStates::Default);
+    void Draw(const sf::Text& text, const sf::RenderStates& states = sf::RenderStates::Default);
+    void Draw(const sf::VertexArray& vertices, const sf::RenderStates& states = sf::RenderStates::Default);
+    void Draw(const sf::VertexBuffer& buffer, const sf::RenderStates& states = sf::RenderStates::Default);
+    void Draw(const sf::VertexBuffer& buffer, std::size_t firstVertex, std::size_t vertexCount,
+        const sf::RenderStates& states = sf::RenderStates::Default);
+    void Draw(const sf::Vertex* vertices, std::size_t count, sf::PrimitiveType type,
+        const sf::RenderStates& states = sf::RenderStates::Default);
+    // Fallback for drawables we cannot inspect (counted as one call, unknown vertices)
+    void Draw(const sf::Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default);
+
+    // Results of the last completed frame
+    const RenderCounters& FrameCounters() const { return m_lastFrame; }
+    const RenderCounters& PassCounters(RenderPass pass) const { return m_lastPasses[static_cast<std::size_t>(pass)]; }
+    unsigned long long FrameIndex() const { return m_frameIndex; }
+    std::string Summary() const;
+
+    // CSV dump: one row per pass plus a total row for every frame
+    bool StartCsv(const std::string& path);
+    void StopCsv();
+    bool IsCsvActive() const { return m_csv.is_open(); }
+
+    static const char* PassName(RenderPass pass);
+
+private:
+    void record(const sf::Texture* texture, const sf::RenderStates& states, std::size_t vertexCount);
+    void writeCsvFrame();
+
+private:
+    sf::RenderTarget* m_target;
+    RenderPass m_pass = RenderPass::UI;
+
+    std::array<RenderCounters, static_cast<std::size_t>(RenderPass::Count)> m_passes{};
+    std::array<RenderCounters, static_cast<std::size_t>(RenderPass::Count)> m_lastPasses{};
+    RenderCounters m_lastFrame;
+    unsigned long long m_frameIndex = 0;
+
+    // Last submitted state, used to detect binds / state changes
+    bool m_hasLast = false;
+    const sf::Texture* m_lastTexture = nullptr;
+    sf::BlendMode m_lastBlend;
+    const sf::Shader* m_lastShader = nullptr;
+
+    std::ofstream m_csv;
+};
@@ -0,0 +1,266 @@
+#include "ResourceCache.h"
+#include "DecodedTextureCache.h"
+#include "TextureBaker.h"
+#include <filesystem>
+#include <iostream>
+
+ResourceCache& ResourceCache::Shared()
+{
+    static ResourceCache cache;
+    return cache;
+}
+
+std::string ResourceCache::Normalize(const std::string& path)
+{
+    return AssetPackFormat::NormalizePath(path);
+}
+
+bool ResourceCache::MountPack(const std::string& path)
+{
+    if (!m_pack.Mount(path)) return false;
+    std::cout << "Mounted asset pack " << path << " (" << m_pack.EntryCount() << " files)\n";
+    return true;
+}
+
+std::unique_ptr<sf::InputStream> ResourceCache::OpenPackStream(const std::string& path) const
+{
+    const PackBlob blob = m_pack.Find(path);
+    if (!blob) return nullptr;
+    return std::make_unique<PackStream>(blob);
+}
+
+template <typename T>
+bool ResourceCache::loadResource(T& resource, const std::string& path, const std::string& key) const
+{
+    if (const PackBlob blob = m_pack.FindNormalized(key)) {
+        PackStream stream(blob);
+        return resource.loadFromStream(stream);
+    }
+    return resource.loadFromFile(path);
+}
+
+// FreeType keeps reading the face after loading, so fonts take the mapped
+// bytes directly (the pack stays mounted for the life of the cache)
+template <>
+bool ResourceCache::loadResource(sf::Font& font, const std::string& path, const std::string& key) const
+{
+    if (const PackBlob blob = m_pack.FindNormalized(key))
+        return font.loadFromMemory(blob.data, blob.size);
+    return font.loadFromFile(path);
+}
+
+template <typename T>
+std::shared_ptr<const T> ResourceCache::find(const Table<T>& table, const std::string& key)
+{
+    auto it = table.find(key);
+    if (it == table.end()) {
+        ++m_misses;
+        return nullptr;
+    }
+    ++m_hits;
+    return it->second.resource;
+}
+
+bool ResourceCache::DecodeImage(const std::string& path, sf::Image& image, float scale) const
+{
+    DecodedTextureCache& decoded = DecodedTextureCache::Shared();
+    const PackBlob blob = m_pack.Find(path);
+
+    if (auto cached = decoded.Open(path, blob, scale)) {
+        image.create(cached->width, cached->height, cached->pixels);
+        return true;
+    }
+
+    PackStream stream(blob);
+    if (!(blob ? image.loadFromStream(stream) : image.loadFromFile(path))) return false;
+    if (scale != 1.f) {
+        // Bakes are stored on their own, so the full-size decode is never cached here
+        sf::Image source = image;
+        if (!TextureBaker::Resample(source, scale, image)) return false;
+    }
+    if (decoded.PremultipliedAlpha()) DecodedTextureCache::Premultiply(image);
+    decoded.Store(path, blob, image, scale);
+    return true;
+}
+
+std::string ResourceCache::imageKey(const std::string& path, float scale)
+{
+    return scale == 1.f ? Normalize(path) : Normalize(path) + "@" + std::to_string(scale);
+}
+
+std::shared_ptr<const sf::Image> ResourceCache::GetImage(const std::string& path, float scale)
+{
+    const std::string key = imageKey(path, scale);
+    if (auto hit = find(m_images, key)) return hit;
+    return loadImage(key, path, scale);
+}
+
+std::shared_ptr<const sf::Image> ResourceCache::loadImage(const std::string& key, const std::string& path, float scale)
+{
+    auto image = std::make_shared<sf::Image>();
+    if (!DecodeImage(path, *image, scale)) {
+        std::cerr << "Warning: image failed to load: " << path << "\n";
+        return nullptr;
+    }
+    const sf::Vector2u size = image->getSize();
+    m_images[key] = { image, static_cast<std::size_t>(size.x) * size.y * 4 };
+    return image;
+}
+
+std::string ResourceCache::textureKey(const std::string& path, bool smooth, bool repeated)
+{
+    return Normalize(path) + (smooth ? "|smooth" : "") + (repeated ? "|repeated" : "");
+}
+
+std::shared_ptr<const sf::Texture> ResourceCache::GetTexture(const std::string& path, bool smooth, bool repeated)
+{
+    const std::string key = textureKey(path, smooth, repeated);
+    if (auto hit = find(m_textures, key)) return hit;
+
+    // The image lookup below is part of this miss, not a lookup of its own
+    const std::string plainKey = Normalize(path);
+    auto cachedImage = m_images.find(plainKey);
+    std::shared_ptr<const sf::Image> image;
+    if (cachedImage != m_images.end()) {
+        image = cachedImage->second.resource;
+    }
+    else {
+        // Nobody needs the pixels on the CPU: upload straight from the mapped cache entry
+        if (auto cached = DecodedTextureCache::Shared().Open(path, m_pack.Find(path)))
+            return uploadTexture(key, path, smooth, repeated, *cached);
+        image = loadImage(plainKey, path, 1.f);
+    }
+    if (!image) return nullptr;
+
+    auto tex = std::make_shared<sf::Texture>();
+    if (!tex->loadFromImage(*image)) {
+        std::cerr << "Warning: texture upload failed: " << path << "\n";
+        return nullptr;
+    }
+    tex->setSmooth(smooth);
+    tex->setRepeated(repeated);
+    const sf::Vector2u size = tex->getSize();
+    m_textures[key] = { tex, static_cast<std::size_t>(size.x) * size.y * 4 };
+    return tex;
+}
+
+std::shared_ptr<const sf::Texture> ResourceCache::uploadTexture(const std::string& key, const std::string& path,
+    bool smooth, bool repeated, const DecodedBlob& blob)
+{
+    auto tex = std::make_shared<sf::Texture>();
+    if (!tex->create(blob.width, blob.height)) {
+        std::cerr << "Warning: texture upload failed: " << path << "\n";
+        return nullptr;
+    }
+    tex->update(blob.pixels);
+    tex->setSmooth(smooth);
+    tex->setRepeated(repeated);
+    m_textures[key] = { tex, static_cast<std::size_t>(blob.width) * blob.height * 4 };
+    return tex;
+}
+
+std::shared_ptr<const sf::SoundBuffer> ResourceCache::GetSoundBuffer(const std::string& path)
+{
+    const std::string key = Normalize(path);
+    if (auto hit = find(m_soundBuffers, key)) return hit;
+
+    auto buffer = std::make_shared<sf::SoundBuffer>();
+    if (!loadResource(*buffer, path, key)) {
+        std::cerr << "Warning: sound buffer failed to load: " << path << "\n";
+        return nullptr;
+    }
+    m_soundBuffers[key] = { buffer, static_cast<std::size_t>(buffer->getSampleCount()) * sizeof(sf::Int16) };
+    return buffer;
+}
+
+std::shared_ptr<const sf::Font> ResourceCache::GetFont(const std::string& path)
+{
+    const std::string key = Normalize(path);
+    if (auto hit = find(m_fonts, key)) return hit;
+
+    auto font = std::make_shared<sf::Font>();
+    if (!loadResource(*font, path, key)) {
+        std::cerr << "Warning: font failed to load: " << path << "\n";
+        return nullptr;
+    }
+    // FreeType reads the face on demand; the file size is an upper bound
+    std::size_t bytes = m_pack.FindNormalized(key).size;
+    if (bytes == 0) {
+        std::error_code ec;
+        const auto fileSize = std::filesystem::file_size(path, ec);
+        bytes = ec ? 0 : static_cast<std::size_t>(fileSize);
+    }
+    m_fonts[key] = { font, bytes };
+    return font;
+}
+
+std::shared_ptr<const sf::Texture> ResourceCache::AddTexture(const std::string& path, bool smooth, bool repeated, const DecodedBlob& blob)
+{
+    const std::string key = textureKey(path, smooth, repeated);
+    auto it = m_textures.find(key);
+    if (it != m_textures.end()) return it->second.resource;
+    return uploadTexture(key, path, smooth, repeated, blob);
+}
+
+void ResourceCache::AddImage(const std::string& path, std::shared_ptr<const sf::Image> image, float scale)
+{
+    if (!image) return;
+    const sf::Vector2u size = image->getSize();
+    m_images.try_emplace(imageKey(path, scale), Entry<sf::Image>{ std::move(image), static_cast<std::size_t>(size.x) * size.y * 4 });
+}
+
+void ResourceCache::AddSoundBuffer(const std::string& path, std::shared_ptr<const sf::SoundBuffer> buffer)
+{
+    if (!buffer) return;
+    const std::size_t bytes = static_cast<std::size_t>(buffer->getSampleCount()) * sizeof(sf::Int16);
+    m_soundBuffers.try_emplace(Normalize(path), Entry<sf::SoundBuffer>{ std::move(buffer), bytes });
+}
+
+void ResourceCache::Trim()
+{
+    auto trim = [](auto& table) {
+        for (auto it = table.begin(); it != table.end(); ) {
+            if (it->second.resource.use_count() == 1) it = table.erase(it);
+            else ++it;
+        }
+    };
+    // Decoded images only stay while something other than a texture needs them
+    trim(m_textures);
+    trim(m_images);
+    trim(m_soundBuffers);
+    trim(m_fonts);
+}
+
+float ResourceCache::HitRate() const
+{
+    const std::uint64_t total = m_hits + m_misses;
+    return total ? static_cast<float>(m_hits) / static_cast<float>(total) : 0.f;
+}
+
+std::size_t ResourceCache::EntryCount() const
+{
+    return m_textures.size() + m_images.size() + m_soundBuffers.size() + m_fonts.size();
+}
+
+std::size_t ResourceCache::ResidentBytes() const
+{
+    std::size_t bytes = 0;
+    auto sum = [&bytes](const auto& table) {
+        for (const auto& entry : table) bytes += entry.second.bytes;
+    };
+    sum(m_textures);
+    sum(m_images);
+    sum(m_soundBuffers);
+    sum(m_fonts);
+    return bytes;
+}
+
+std::string ResourceCache::Summary() const
+{
+    const DecodedTextureCache& decoded = DecodedTextureCache::Shared();
+    return "Assets " + std::to_string(EntryCount()) + " entries, " +
+        std::to_string(ResidentBytes() / (1024 * 1024)) + " MB, hit rate " +
+        std::to_string(static_cast<int>(HitRate() * 100.f + 0.5f)) + "% (" +
+        std::to_string(m_hits) + "/" + std::to_string(m_hits + m_misses) + "), texcache " +
+        std::to_string(decoded.Hits()) + " hit " + std::to_string(decoded.Misses() + decoded.Stale()) + " miss";
+}
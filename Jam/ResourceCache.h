@@ -0,0 +1,96 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "AssetPack.h"
+
+struct DecodedBlob;
+
+// Process-wide cache of loaded assets. Paths are normalised (separators,
+// "." / ".." segments, case) so "assets/Audio/x.wav" and
+// "Assets\\audio\\x.wav" resolve to the same entry. Callers get shared
+// handles; an entry stays resident while anything holds its handle and
+// until the next Trim() after that.
+class ResourceCache {
+public:
+    static ResourceCache& Shared();
+
+    static std::string Normalize(const std::string& path);
+
+    // Serve files from a pack first, loose files second. Returns false if
+    // the pack is missing or invalid; loose files keep working either way.
+    bool MountPack(const std::string& path);
+    const AssetPack& Pack() const { return m_pack; }
+
+    // Stream for resources that read lazily over their lifetime (sf::Music).
+    // nullptr if the file is not in the mounted pack.
+    std::unique_ptr<sf::InputStream> OpenPackStream(const std::string& path) const;
+
+    // All getters return nullptr (and warn) if the file fails to load.
+    // Textures are built from the cached decoded image, so an image that
+    // is also cut into animation frames is only decoded once.
+    std::shared_ptr<const sf::Texture> GetTexture(const std::string& path, bool smooth = false, bool repeated = false);
+    // `scale` < 1 returns a TextureBaker bake of the image at that scale
+    std::shared_ptr<const sf::Image> GetImage(const std::string& path, float scale = 1.f);
+    std::shared_ptr<const sf::SoundBuffer> GetSoundBuffer(const std::string& path);
+    std::shared_ptr<const sf::Font> GetFont(const std::string& path);
+
+    // Decode an image file, going through DecodedTextureCache when it is
+    // enabled. Touches no cache tables, so loader threads may call it.
+    bool DecodeImage(const std::string& path, sf::Image& image, float scale = 1.f) const;
+
+    // Publish data decoded elsewhere (AsyncLoader). An existing entry wins.
+    std::shared_ptr<const sf::Texture> AddTexture(const std::string& path, bool smooth, bool repeated, const DecodedBlob& blob);
+    void AddImage(const std::string& path, std::shared_ptr<const sf::Image> image, float scale = 1.f);
+    void AddSoundBuffer(const std::string& path, std::shared_ptr<const sf::SoundBuffer> buffer);
+
+    // Drop entries nobody outside the cache holds any more
+    void Trim();
+
+    std::uint64_t Hits() const { return m_hits; }
+    std::uint64_t Misses() const { return m_misses; }
+    float HitRate() const;
+    std::size_t EntryCount() const;
+    std::size_t ResidentBytes() const; // decoded estimate: RGBA8 pixels, 16-bit samples, font file size
+
+    // One line for the stats overlay
+    std::string Summary() const;
+
+private:
+    static std::string imageKey(const std::string& path, float scale);
+    static std::string textureKey(const std::string& path, bool smooth, bool repeated);
+    // Decode and cache an image; the caller has done (and counted) the lookup
+    std::shared_ptr<const sf::Image> loadImage(const std::string& key, const std::string& path, float scale);
+    std::shared_ptr<const sf::Texture> uploadTexture(const std::string& key, const std::string& path,
+        bool smooth, bool repeated, const DecodedBlob& blob);
+
+    template <typename T>
+    bool loadResource(T& resource, const std::string& path, const std::string& key) const;
+
+private:
+    template <typename T>
+    struct Entry {
+        std::shared_ptr<const T> resource;
+        std::size_t bytes = 0;
+    };
+    template <typename T>
+    using Table = std::unordered_map<std::string, Entry<T>>;
+
+    template <typename T>
+    std::shared_ptr<const T> find(const Table<T>& table, const std::string& key);
+
+private:
+    AssetPack m_pack;
+
+    Table<sf::Texture> m_textures;
+    Table<sf::Image> m_images;
+    Table<sf::SoundBuffer> m_soundBuffers;
+    Table<sf::Font> m_fonts;
+
+    std::uint64_t m_hits = 0;
+    std::uint64_t m_misses = 0;
+};
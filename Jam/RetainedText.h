@@ -0,0 +1,46 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+
+// sf::Text wrapper for HUD/menu labels that rarely change.
+// The string is compared in its narrow form before being handed to SFML,
+// so an unchanged label costs a string compare instead of a UTF-32
+// conversion, glyph rebuild and bounds query every frame.
+class RetainedText {
+public:
+    RetainedText() = default;
+
+    void SetFont(const sf::Font& font) { m_text.setFont(font); m_dirty = true; }
+    void SetCharacterSize(unsigned size) { m_text.setCharacterSize(size); m_dirty = true; }
+    void SetStyle(sf::Uint32 style) { m_text.setStyle(style); m_dirty = true; }
+    void SetFillColor(const sf::Color& c) { m_text.setFillColor(c); }
+    void SetOutline(float thickness, const sf::Color& c) { m_text.setOutlineThickness(thickness); m_text.setOutlineColor(c); m_dirty = true; }
+    void SetPosition(const sf::Vector2f& p) { m_text.setPosition(p); }
+    void SetScale(float s) { m_text.setScale(s, s); }
+
+    // Keep the origin at the centre of the text bounds (recomputed only on change)
+    void SetCentered(bool centered) { m_centered = centered; m_dirty = true; }
+
+    // Returns true when the visible string actually changed
+    bool SetString(const std::string& s)
+    {
+        if (!m_dirty && s == m_cached) return false;
+        m_cached = s;
+        m_text.setString(s);
+        if (m_centered) {
+            const sf::FloatRect b = m_text.getLocalBounds();
+            m_text.setOrigin(b.left + b.width * 0.5f, b.top + b.height * 0.5f);
+        }
+        m_dirty = false;
+        return true;
+    }
+
+    const std::string& String() const { return m_cached; }
+    const sf::Text& Text() const { return m_text; }
+
+private:
+    sf::Text m_text;
+    std::string m_cached;
+    bool m_centered = false;
+    bool m_dirty = true;
+};
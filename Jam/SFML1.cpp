@@ -1,7 +1,22 @@
 ﻿#include "Game.h"
+#include "AnimationBenchmark.h"
+#include "AudioBenchmark.h"
+#include <cstring>
 
-int main()
+int main(int argc, char** argv)
 {
+    // Benchmarks run on their own, before the game opens a window or starts any audio
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--audio-benchmark") == 0)
+            return AudioBenchmark::Run(i + 1 < argc ? argv[i + 1] : "audio_benchmark.csv") ? 0 : 1;
+        if (std::strcmp(argv[i], "--animation-benchmark") == 0)
+            return AnimationBenchmark::Run(i + 1 < argc ? argv[i + 1] : "animation_benchmark.csv") ? 0 : 1;
+    }
+
     Game game;
+    for (int i = 1; i < argc; ++i) {
+        // Software-mixed effects with bus inserts, at the cost of trigger latency
+        if (std::strcmp(argv[i], "--bus-effects") == 0) game.SetBusEffects(true);
+    }
     return game.Run();
 }
@@ -0,0 +1,234 @@
+#include "SoftwareMixer.h"
+#include "MixKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+SoftwareMixer::SoftwareMixer(unsigned voiceCount)
+    : m_voices(std::max(1u, voiceCount))
+    , m_started(m_voices.size(), 0)
+    , m_ended(std::make_unique<std::atomic<std::uint32_t>[]>(m_voices.size()))
+    , m_accum(BLOCK_FRAMES * 2)
+    , m_block(BLOCK_FRAMES * 2)
+{
+    for (std::size_t b = 0; b < AUDIO_CATEGORY_COUNT; ++b) {
+        m_busAccum[b].resize(BLOCK_FRAMES * 2);
+        m_effects[b].Prepare(SAMPLE_RATE);
+    }
+    initialize(2, SAMPLE_RATE);
+    setProcessingInterval(sf::milliseconds(POLL_MILLISECONDS));
+}
+
+SoftwareMixer::~SoftwareMixer()
+{
+    // The stream thread calls onGetData; stop it while the voices still exist
+    stop();
+}
+
+void SoftwareMixer::post(const Command& c)
+{
+    // Full only if the stream thread has stalled; wait rather than drop a voice
+    while (!m_commands.TryPush(c)) std::this_thread::yield();
+}
+
+void SoftwareMixer::Start(int voice, AudioCategory bus, std::shared_ptr<const sf::SoundBuffer> buffer, bool loop,
+    sf::Time offset, float volume, float pan, float pitch, bool paused)
+{
+    if (!buffer) return;
+    Command c;
+    c.type = Command::Type::Start;
+    c.voice = voice;
+    c.bus = static_cast<std::uint8_t>(bus);
+    c.serial = ++m_started[static_cast<std::size_t>(voice)];
+    c.offset = std::floor(offset.asSeconds() * static_cast<double>(buffer->getSampleRate()));
+    c.buffer = std::move(buffer);
+    c.volume = volume;
+    c.pan = pan;
+    c.pitch = pitch;
+    c.loop = loop;
+    c.paused = paused;
+    post(c);
+}
+
+void SoftwareMixer::Stop(int voice)
+{
+    Command c;
+    c.type = Command::Type::Stop;
+    c.voice = voice;
+    post(c);
+}
+
+void SoftwareMixer::SetPaused(int voice, bool paused)
+{
+    Command c;
+    c.type = paused ? Command::Type::Pause : Command::Type::Resume;
+    c.voice = voice;
+    post(c);
+}
+
+void SoftwareMixer::SetGain(int voice, float volume, float pan)
+{
+    Command c;
+    c.type = Command::Type::Gain;
+    c.voice = voice;
+    c.volume = volume;
+    c.pan = pan;
+    post(c);
+}
+
+bool SoftwareMixer::IsFinished(int voice) const
+{
+    const std::size_t i = static_cast<std::size_t>(voice);
+    return m_ended[i].load(std::memory_order_acquire) == m_started[i];
+}
+
+void SoftwareMixer::gains(unsigned channels, float volume, float pan, float& left, float& right)
+{
+    volume = std::max(0.f, volume);
+    if (channels != 1) {
+        left = right = volume;
+        return;
+    }
+    // Equal power, like OpenAL's own stereo panning: -3 dB per side at centre
+    const float angle = (std::clamp(pan, -1.f, 1.f) + 1.f) * 0.785398163f;
+    left = std::cos(angle) * volume;
+    right = std::sin(angle) * volume;
+}
+
+void SoftwareMixer::apply(const Command& c)
+{
+    Voice& v = m_voices[static_cast<std::size_t>(c.voice)];
+    switch (c.type) {
+    case Command::Type::Start: {
+        const sf::SoundBuffer& buffer = *c.buffer;
+        v.channels = std::max(1u, buffer.getChannelCount());
+        v.frames = static_cast<std::size_t>(buffer.getSampleCount()) / v.channels;
+        v.samples = buffer.getSamples();
+        v.serial = c.serial;
+        v.bus = c.bus;
+        v.loop = c.loop;
+        v.paused = c.paused;
+        v.step = static_cast<double>(c.pitch) * buffer.getSampleRate() / SAMPLE_RATE;
+        v.position = c.offset;
+        if (v.loop && v.frames > 0) v.position = std::fmod(v.position, static_cast<double>(v.frames));
+        gains(v.channels, c.volume, c.pan, v.targetL, v.targetR);
+        // Starts at full gain: ramping up would soften the attack
+        v.gainL = v.targetL;
+        v.gainR = v.targetR;
+        v.buffer = c.buffer;
+        v.active = v.frames > 0 && v.step > 0.0 && v.position < static_cast<double>(v.frames);
+        if (!v.active) {
+            v.buffer.reset();
+            m_ended[static_cast<std::size_t>(c.voice)].store(v.serial, std::memory_order_release);
+        }
+        break;
+    }
+    case Command::Type::Stop:
+        v.active = false;
+        v.buffer.reset();
+        break;
+    case Command::Type::Pause:
+        v.paused = true;
+        break;
+    case Command::Type::Resume:
+        v.paused = false;
+        break;
+    case Command::Type::Gain:
+        gains(v.channels, c.volume, c.pan, v.targetL, v.targetR);
+        break;
+    }
+}
+
+void SoftwareMixer::mixVoice(Voice& v, std::size_t index, float* accum)
+{
+    // Gain changes ramp across the block
+    const float stepL = (v.targetL - v.gainL) / static_cast<float>(BLOCK_FRAMES);
+    const float stepR = (v.targetR - v.gainR) / static_cast<float>(BLOCK_FRAMES);
+    float gainL = v.gainL;
+    float gainR = v.gainR;
+    // 1:1 playback takes the vector kernels; pitch or rate changes resample
+    const bool direct = v.step == 1.0 && v.channels <= 2;
+    const double length = static_cast<double>(v.frames);
+
+    std::size_t done = 0;
+    while (done < BLOCK_FRAMES) {
+        float* out = accum + done * 2;
+        std::size_t n;
+        if (direct) {
+            const std::size_t at = static_cast<std::size_t>(v.position);
+            n = std::min(BLOCK_FRAMES - done, v.frames - at);
+            const sf::Int16* in = v.samples + at * v.channels;
+            if (v.channels == 1) MixKernels::MonoToStereo(out, in, n, gainL, gainR, stepL, stepR);
+            else MixKernels::StereoToStereo(out, in, n, gainL, gainR, stepL, stepR);
+            v.position += static_cast<double>(n);
+        }
+        else {
+            n = MixKernels::Resample(out, v.samples, v.channels, v.frames, v.position, v.step, v.loop,
+                BLOCK_FRAMES - done, gainL, gainR, stepL, stepR);
+        }
+        gainL += stepL * static_cast<float>(n);
+        gainR += stepR * static_cast<float>(n);
+        done += n;
+
+        if (v.position >= length) {
+            if (!v.loop) {
+                v.active = false;
+                v.buffer.reset();
+                m_ended[index].store(v.serial, std::memory_order_release);
+                break;
+            }
+            v.position = std::fmod(v.position, length);
+        }
+    }
+
+    v.gainL = v.targetL;
+    v.gainR = v.targetR;
+}
+
+void SoftwareMixer::mix(sf::Int16* out)
+{
+    Command c;
+    while (m_commands.TryPop(c)) apply(c);
+
+    // Buses without inserts go straight into the mix
+    std::array<float*, AUDIO_CATEGORY_COUNT> target;
+    std::array<bool, AUDIO_CATEGORY_COUNT> inserts;
+    std::fill(m_accum.begin(), m_accum.end(), 0.f);
+    for (std::size_t b = 0; b < AUDIO_CATEGORY_COUNT; ++b) {
+        inserts[b] = m_effects[b].Active();
+        target[b] = m_accum.data();
+        if (!inserts[b]) continue;
+        std::fill(m_busAccum[b].begin(), m_busAccum[b].end(), 0.f);
+        target[b] = m_busAccum[b].data();
+    }
+
+    for (std::size_t i = 0; i < m_voices.size(); ++i) {
+        Voice& v = m_voices[i];
+        if (v.active && !v.paused) mixVoice(v, i, target[v.bus]);
+    }
+
+    // Inserts run even on a silent bus so reverb tails ring out
+    for (std::size_t b = 0; b < AUDIO_CATEGORY_COUNT; ++b) {
+        if (!inserts[b]) continue;
+        float* bus = m_busAccum[b].data();
+        m_effects[b].Process(bus, BLOCK_FRAMES);
+        for (std::size_t i = 0; i < m_accum.size(); ++i) m_accum[i] += bus[i];
+    }
+    MixKernels::FloatToInt16(out, m_accum.data(), m_accum.size());
+}
+
+void SoftwareMixer::RenderBlock(sf::Int16* out)
+{
+    mix(out);
+}
+
+bool SoftwareMixer::onGetData(Chunk& data)
+{
+    sf::Clock clock;
+    mix(m_block.data());
+    m_blockMicroseconds.store(static_cast<float>(clock.getElapsedTime().asMicroseconds()), std::memory_order_relaxed);
+
+    data.samples = m_block.data();
+    data.sampleCount = m_block.size();
+    return true; // silence while idle; the stream never ends
+}
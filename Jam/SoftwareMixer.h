@@ -0,0 +1,116 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "SpscQueue.h"
+#include "AudioEmitter.h"
+#include "BusEffects.h"
+
+// Mixes any number of voices into one stereo sf::SoundStream, so the
+// whole voice pool costs one OpenAL source instead of one per sf::Sound.
+// Each voice has its own gain, pan and pitch; buffers at other sample
+// rates are resampled on the fly. Voices mix into the bus of their
+// category; a bus with insert effects running is mixed on its own, put
+// through them and then added to the rest.
+//
+// The controlling thread (the audio thread, or the game thread when it is
+// not running) talks to the stream thread through a lock-free queue; the
+// voice settles within one block. Trigger latency is the stream's
+// buffering: LatencySeconds().
+class SoftwareMixer : public sf::SoundStream {
+public:
+    static constexpr unsigned SAMPLE_RATE = 44100;
+    static constexpr std::size_t BLOCK_FRAMES = 512; // ~11.6 ms
+    static constexpr int POLL_MILLISECONDS = 5;      // stream thread refill interval
+
+    explicit SoftwareMixer(unsigned voiceCount);
+    ~SoftwareMixer() override;
+
+    SoftwareMixer(const SoftwareMixer&) = delete;
+    SoftwareMixer& operator=(const SoftwareMixer&) = delete;
+
+    unsigned VoiceCount() const { return static_cast<unsigned>(m_voices.size()); }
+
+    // Controlling thread. Volume is 0..1, pan -1..1 (mono buffers only;
+    // stereo ones play as authored, like OpenAL does), pitch 1 = as recorded.
+    // The buffer is kept alive by the voice until it stops.
+    void Start(int voice, AudioCategory bus, std::shared_ptr<const sf::SoundBuffer> buffer, bool loop,
+        sf::Time offset, float volume, float pan, float pitch, bool paused);
+    void Stop(int voice);
+    void SetPaused(int voice, bool paused);
+    void SetGain(int voice, float volume, float pan);
+    // The last Start on this voice has played to its end
+    bool IsFinished(int voice) const;
+
+    // Inserts of one category's bus; parameters may be set from any thread
+    BusEffects& Effects(AudioCategory bus) { return m_effects[static_cast<std::size_t>(bus)]; }
+    const BusEffects& Effects(AudioCategory bus) const { return m_effects[static_cast<std::size_t>(bus)]; }
+
+    // Mix one block without the stream thread (benchmarks); only while stopped
+    void RenderBlock(sf::Int16* out);
+
+    // Stream thread time spent mixing the last block
+    float LastBlockMicroseconds() const { return m_blockMicroseconds.load(std::memory_order_relaxed); }
+    // Worst case from a command reaching the stream thread to it being
+    // heard: sf::SoundStream's three queued blocks plus one poll interval
+    static float LatencySeconds() { return 3.f * BLOCK_FRAMES / SAMPLE_RATE + POLL_MILLISECONDS / 1000.f; }
+
+protected:
+    bool onGetData(Chunk& data) override;
+    void onSeek(sf::Time) override {}
+
+private:
+    struct Command {
+        enum class Type : std::uint8_t { Start, Stop, Pause, Resume, Gain };
+        Type type = Type::Start;
+        int voice = 0;
+        std::uint8_t bus = 0;
+        std::uint32_t serial = 0; // Start: numbers this play of the voice
+        std::shared_ptr<const sf::SoundBuffer> buffer;
+        double offset = 0.0; // source frames
+        float volume = 0.f;
+        float pan = 0.f;
+        float pitch = 1.f;
+        bool loop = false;
+        bool paused = false;
+    };
+
+    // Stream thread
+    struct Voice {
+        std::shared_ptr<const sf::SoundBuffer> buffer;
+        const sf::Int16* samples = nullptr;
+        std::size_t frames = 0;
+        unsigned channels = 1;
+        double position = 0.0; // source frames
+        double step = 1.0;     // source frames per output frame
+        float gainL = 0.f;     // at the end of the last block
+        float gainR = 0.f;
+        float targetL = 0.f;
+        float targetR = 0.f;
+        std::uint32_t serial = 0;
+        std::size_t bus = 0;
+        bool loop = false;
+        bool paused = false;
+        bool active = false;
+    };
+
+    void post(const Command& c);
+    void apply(const Command& c);
+    void mixVoice(Voice& v, std::size_t index, float* accum);
+    void mix(sf::Int16* out);
+    static void gains(unsigned channels, float volume, float pan, float& left, float& right);
+
+    SpscQueue<Command, 1024> m_commands;
+    std::vector<Voice> m_voices;
+    std::vector<std::uint32_t> m_started;                 // controlling thread: serial of the last Start
+    std::unique_ptr<std::atomic<std::uint32_t>[]> m_ended; // stream thread: serial of the last play that ended
+    std::vector<float> m_accum;                                     // the whole mix
+    std::array<std::vector<float>, AUDIO_CATEGORY_COUNT> m_busAccum; // buses with inserts running
+    std::array<BusEffects, AUDIO_CATEGORY_COUNT> m_effects;
+    std::vector<sf::Int16> m_block;
+    std::atomic<float> m_blockMicroseconds{ 0.f };
+};
@@ -0,0 +1,301 @@
+#include "SoundBank.h"
+#include "ResourceCache.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+SoundBank& SoundBank::Shared()
+{
+    static SoundBank bank;
+    return bank;
+}
+
+SoundBank::SoundBank()
+{
+    m_worker = std::thread(&SoundBank::workerLoop, this);
+}
+
+SoundBank::~SoundBank()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_jobMutex);
+        m_stopping = true;
+        m_jobs.clear();
+    }
+    m_jobReady.notify_all();
+    m_worker.join();
+}
+
+std::string SoundBank::compressedSibling(const std::string& path)
+{
+    const std::size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos) return {};
+    std::string ext = path.substr(dot);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".wav" ? path.substr(0, dot) + ".ogg" : std::string();
+}
+
+bool SoundBank::isCompressed(const std::string& path)
+{
+    const std::size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos) return false;
+    std::string ext = path.substr(dot);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".ogg" || ext == ".flac";
+}
+
+bool SoundBank::open(const Source& source, sf::InputSoundFile& file)
+{
+    if (source.blob) return file.openFromMemory(source.blob.data, source.blob.size);
+    if (source.bytes) return file.openFromMemory(source.bytes->data(), source.bytes->size());
+    return file.openFromFile(source.file);
+}
+
+void SoundBank::decode(Decoded& out)
+{
+    // Worker thread or main thread: file reads and decoding only, no AL calls
+    sf::InputSoundFile file;
+    if (!open(out.source, file)) return;
+    out.channelCount = file.getChannelCount();
+    out.sampleRate = file.getSampleRate();
+    out.samples.resize(static_cast<std::size_t>(file.getSampleCount()));
+    const sf::Uint64 read = file.read(out.samples.data(), out.samples.size());
+    out.samples.resize(static_cast<std::size_t>(read));
+    out.ok = read > 0;
+}
+
+SoundBank::Sound* SoundBank::find(const std::string& path)
+{
+    auto it = m_sounds.find(ResourceCache::Normalize(path));
+    return it != m_sounds.end() ? &it->second : nullptr;
+}
+
+const SoundBank::Sound* SoundBank::find(const std::string& path) const
+{
+    auto it = m_sounds.find(ResourceCache::Normalize(path));
+    return it != m_sounds.end() ? &it->second : nullptr;
+}
+
+bool SoundBank::Add(const std::string& path)
+{
+    const std::string key = ResourceCache::Normalize(path);
+    if (m_sounds.count(key)) return true;
+
+    // An .ogg next to the .wav is the compressed export of the same sound
+    const AssetPack& pack = ResourceCache::Shared().Pack();
+    Sound sound;
+    bool found = false;
+    for (const std::string& candidate : { compressedSibling(path), path }) {
+        if (candidate.empty()) continue;
+        sound.compressed = isCompressed(candidate);
+        if (const PackBlob blob = pack.Find(candidate)) {
+            sound.source.blob = blob;
+            found = true;
+            break;
+        }
+        std::error_code ec;
+        if (!std::filesystem::is_regular_file(candidate, ec)) continue;
+        found = true;
+        if (!sound.compressed) {
+            sound.source.file = candidate;
+            break;
+        }
+        std::ifstream in(candidate, std::ios::binary);
+        auto bytes = std::make_shared<std::vector<char>>(
+            static_cast<std::size_t>(std::filesystem::file_size(candidate, ec)));
+        if (ec || !in.read(bytes->data(), static_cast<std::streamsize>(bytes->size()))) {
+            std::cerr << "Warning: sound failed to read: " << candidate << "\n";
+            return false;
+        }
+        sound.source.bytes = std::move(bytes);
+        break;
+    }
+    if (!found) {
+        std::cerr << "Warning: sound not found: " << path << "\n";
+        return false;
+    }
+
+    sf::InputSoundFile header;
+    if (!open(sound.source, header)) {
+        std::cerr << "Warning: sound failed to open: " << path << "\n";
+        return false;
+    }
+    sound.pcmBytes = static_cast<std::size_t>(header.getSampleCount()) * sizeof(sf::Int16);
+    m_sounds.emplace(key, std::move(sound));
+    return true;
+}
+
+bool SoundBank::Contains(const std::string& path) const
+{
+    return find(path) != nullptr;
+}
+
+bool SoundBank::Resident(const std::string& path) const
+{
+    const Sound* sound = find(path);
+    return sound && sound->buffer;
+}
+
+bool SoundBank::Failed(const std::string& path) const
+{
+    const Sound* sound = find(path);
+    return sound && sound->failed;
+}
+
+std::shared_ptr<const sf::SoundBuffer> SoundBank::publish(Sound& sound, const Decoded& decoded)
+{
+    if (!decoded.ok) {
+        std::cerr << "Warning: sound failed to decode: " << decoded.key << "\n";
+        sound.failed = true;
+        return nullptr;
+    }
+    auto buffer = std::make_shared<sf::SoundBuffer>();
+    if (!buffer->loadFromSamples(decoded.samples.data(), decoded.samples.size(), decoded.channelCount, decoded.sampleRate)) {
+        std::cerr << "Warning: sound upload failed: " << decoded.key << "\n";
+        sound.failed = true;
+        return nullptr;
+    }
+    sound.buffer = buffer;
+    return buffer;
+}
+
+std::shared_ptr<const sf::SoundBuffer> SoundBank::Acquire(const std::string& path)
+{
+    Sound* sound = find(path);
+    if (!sound) {
+        std::cerr << "Warning: sound is not in the bank: " << path << "\n";
+        return nullptr;
+    }
+    sound->lastUse = ++m_useClock;
+    if (sound->buffer) {
+        ++m_hits;
+        return sound->buffer;
+    }
+    if (sound->failed) return nullptr; // warned when it failed
+
+    // Not prefetched (or not yet): decode here. A prefetch still in
+    // flight is dropped when Pump finds the sound resident.
+    ++m_misses;
+    Decoded decoded;
+    decoded.key = ResourceCache::Normalize(path);
+    decoded.source = sound->source;
+    decode(decoded);
+    auto buffer = publish(*sound, decoded);
+    evict();
+    return buffer;
+}
+
+void SoundBank::Prefetch(const std::string& path)
+{
+    Sound* sound = find(path);
+    if (!sound || sound->buffer || sound->prefetching || sound->failed) return;
+    sound->prefetching = true;
+    sound->lastUse = ++m_useClock;
+
+    Decoded job;
+    job.key = ResourceCache::Normalize(path);
+    job.source = sound->source;
+    {
+        std::lock_guard<std::mutex> lock(m_jobMutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_jobReady.notify_one();
+}
+
+void SoundBank::Pump()
+{
+    std::deque<Decoded> ready;
+    {
+        std::lock_guard<std::mutex> lock(m_doneMutex);
+        ready.swap(m_decoded);
+    }
+    for (auto& entry : m_sounds) entry.second.fresh = false;
+    for (Decoded& decoded : ready) {
+        auto it = m_sounds.find(decoded.key);
+        if (it == m_sounds.end()) continue;
+        Sound& sound = it->second;
+        sound.prefetching = false;
+        if (!sound.buffer) sound.fresh = publish(sound, decoded) != nullptr;
+    }
+    evict();
+}
+
+void SoundBank::SetBudget(std::size_t bytes)
+{
+    m_budget = bytes;
+    evict();
+}
+
+void SoundBank::evict()
+{
+    // Least recently used first, skipping buffers someone still holds
+    std::size_t resident = ResidentBytes();
+    while (resident > m_budget) {
+        Sound* oldest = nullptr;
+        for (auto& entry : m_sounds) {
+            Sound& sound = entry.second;
+            if (!sound.buffer || sound.fresh || sound.buffer.use_count() > 1) continue;
+            if (!oldest || sound.lastUse < oldest->lastUse) oldest = &sound;
+        }
+        if (!oldest) break;
+        resident -= oldest->pcmBytes;
+        oldest->buffer.reset();
+        ++m_evictions;
+    }
+}
+
+void SoundBank::workerLoop()
+{
+    for (;;) {
+        Decoded item;
+        {
+            std::unique_lock<std::mutex> lock(m_jobMutex);
+            m_jobReady.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping) return;
+            item = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        decode(item);
+
+        std::lock_guard<std::mutex> lock(m_doneMutex);
+        m_decoded.push_back(std::move(item));
+    }
+}
+
+std::size_t SoundBank::EncodedBytes() const
+{
+    std::size_t bytes = 0;
+    for (const auto& entry : m_sounds) {
+        const Source& source = entry.second.source;
+        if (source.bytes) bytes += source.bytes->size();
+        else if (entry.second.compressed) bytes += source.blob.size;
+    }
+    return bytes;
+}
+
+std::size_t SoundBank::ResidentBytes() const
+{
+    std::size_t bytes = 0;
+    for (const auto& entry : m_sounds)
+        if (entry.second.buffer) bytes += entry.second.pcmBytes;
+    return bytes;
+}
+
+std::size_t SoundBank::FullyDecodedBytes() const
+{
+    std::size_t bytes = 0;
+    for (const auto& entry : m_sounds) bytes += entry.second.pcmBytes;
+    return bytes;
+}
+
+std::string SoundBank::Summary() const
+{
+    const auto kb = [](std::size_t bytes) { return std::to_string((bytes + 1023) / 1024); };
+    return "Sounds " + std::to_string(m_sounds.size()) + ": " + kb(EncodedBytes()) + " KB encoded + " +
+        kb(ResidentBytes()) + " KB decoded (budget " + kb(m_budget) + " KB, all decoded " +
+        kb(FullyDecodedBytes()) + " KB), " + std::to_string(m_hits) + " hit " + std::to_string(m_misses) +
+        " miss " + std::to_string(m_evictions) + " evicted";
+}
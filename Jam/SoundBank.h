@@ -0,0 +1,119 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "AssetPack.h"
+
+// Sounds kept encoded, decoded into PCM on demand. Add() only reads the
+// header; a compressed file (an .ogg next to the requested .wav wins) is
+// kept in memory as it is, while uncompressed files are read again from
+// the pack or disk when needed. Acquire() returns the decoded buffer,
+// decoding on the spot on a miss. Decoded buffers sit in an LRU under a
+// byte budget; one still held by an emitter or voice is never evicted, so
+// the budget is exceeded only while more is in use than fits.
+//
+// Prefetch() is a hint that a sound will be needed soon: a worker thread
+// decodes it and Pump() (main thread, once per frame) does the OpenAL
+// upload, as AsyncLoader does. Everything else is main thread only.
+class SoundBank {
+public:
+    static constexpr std::size_t DEFAULT_BUDGET = 8 * 1024 * 1024;
+
+    static SoundBank& Shared();
+
+    SoundBank();
+    ~SoundBank();
+
+    SoundBank(const SoundBank&) = delete;
+    SoundBank& operator=(const SoundBank&) = delete;
+
+    // False (and warns) if the file is missing or not a sound. Adding a
+    // sound again is a no-op.
+    bool Add(const std::string& path);
+    bool Contains(const std::string& path) const;
+    bool Resident(const std::string& path) const;
+    // A sound that failed to decode once is not decoded again
+    bool Failed(const std::string& path) const;
+
+    // nullptr (and warns) if the sound was never added or fails to decode
+    std::shared_ptr<const sf::SoundBuffer> Acquire(const std::string& path);
+    void Prefetch(const std::string& path);
+    // Publishes finished prefetches and evicts down to the budget
+    void Pump();
+
+    void SetBudget(std::size_t bytes);
+    std::size_t Budget() const { return m_budget; }
+
+    std::size_t EncodedBytes() const;      // compressed data held in memory
+    std::size_t ResidentBytes() const;     // decoded PCM in the cache
+    std::size_t FullyDecodedBytes() const; // PCM of every sound, what decoding all up front costs
+    std::uint64_t Hits() const { return m_hits; }
+    std::uint64_t Misses() const { return m_misses; } // decoded on the caller
+    std::uint64_t Evictions() const { return m_evictions; }
+
+    // One line for the stats overlay
+    std::string Summary() const;
+
+private:
+    // Where the encoded bytes are; exactly one is set
+    struct Source {
+        PackBlob blob;                                  // mounted pack
+        std::shared_ptr<const std::vector<char>> bytes; // compressed loose file
+        std::string file;                               // uncompressed loose file
+    };
+
+    struct Sound {
+        Source source;
+        std::size_t pcmBytes = 0;
+        std::shared_ptr<const sf::SoundBuffer> buffer; // null while not resident
+        std::uint64_t lastUse = 0;
+        bool compressed = false;
+        bool prefetching = false;
+        bool failed = false;
+        bool fresh = false; // prefetched this Pump: kept over budget until the next one, so it can be picked up
+    };
+
+    struct Decoded {
+        std::string key;
+        Source source;
+        bool ok = false;
+        std::vector<sf::Int16> samples;
+        unsigned channelCount = 0;
+        unsigned sampleRate = 0;
+    };
+
+    static std::string compressedSibling(const std::string& path);
+    static bool isCompressed(const std::string& path);
+    static bool open(const Source& source, sf::InputSoundFile& file);
+    static void decode(Decoded& out);
+    Sound* find(const std::string& path);
+    const Sound* find(const std::string& path) const;
+    std::shared_ptr<const sf::SoundBuffer> publish(Sound& sound, const Decoded& decoded);
+    void evict();
+    void workerLoop();
+
+private:
+    std::unordered_map<std::string, Sound> m_sounds;
+    std::size_t m_budget = DEFAULT_BUDGET;
+    std::uint64_t m_useClock = 0;
+    std::uint64_t m_hits = 0;
+    std::uint64_t m_misses = 0;
+    std::uint64_t m_evictions = 0;
+
+    std::thread m_worker;
+    std::mutex m_jobMutex;
+    std::condition_variable m_jobReady;
+    std::deque<Decoded> m_jobs;
+    bool m_stopping = false;
+
+    std::mutex m_doneMutex;
+    std::deque<Decoded> m_decoded;
+};
@@ -0,0 +1,377 @@
+#include "SpriteSheet.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+namespace {
+    constexpr unsigned PAGE_LIMIT = 4096;  // keep pages reasonable even if the GPU allows more
+    constexpr unsigned PADDING = 2;        // transparent gap so smoothing never samples a neighbour
+
+    // ------------------------------------------------------------------
+    // Minimal JSON reader: enough for sheet descriptors
+    // ------------------------------------------------------------------
+    struct JsonValue {
+        enum class Type { Null, Bool, Number, String, Array, Object } type = Type::Null;
+        bool boolean = false;
+        double number = 0.0;
+        std::string string;
+        std::vector<JsonValue> array;
+        std::vector<std::pair<std::string, JsonValue>> object; // keeps file order
+
+        const JsonValue* Get(const std::string& key) const {
+            for (const auto& kv : object)
+                if (kv.first == key) return &kv.second;
+            return nullptr;
+        }
+        float Num(const std::string& key, float fallback = 0.f) const {
+            const JsonValue* v = Get(key);
+            return (v && v->type == Type::Number) ? static_cast<float>(v->number) : fallback;
+        }
+    };
+
+    class JsonParser {
+    public:
+        explicit JsonParser(const std::string& text) : m_s(text) {}
+
+        bool Parse(JsonValue& out) {
+            if (!value(out)) return false;
+            skipSpace();
+            return m_pos == m_s.size();
+        }
+
+    private:
+        void skipSpace() {
+            while (m_pos < m_s.size() && std::isspace(static_cast<unsigned char>(m_s[m_pos]))) ++m_pos;
+        }
+
+        bool literal(const char* word) {
+            const std::size_t n = std::char_traits<char>::length(word);
+            if (m_s.compare(m_pos, n, word) != 0) return false;
+            m_pos += n;
+            return true;
+        }
+
+        bool string(std::string& out) {
+            if (m_s[m_pos] != '"') return false;
+            ++m_pos;
+            while (m_pos < m_s.size() && m_s[m_pos] != '"') {
+                char c = m_s[m_pos++];
+                if (c == '\\' && m_pos < m_s.size()) {
+                    c = m_s[m_pos++];
+                    switch (c) {
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case 'r': c = '\r'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case 'u': m_pos = std::min(m_pos + 4, m_s.size()); c = '?'; break; // names are ASCII in practice
+                    default: break; // \" \\ \/
+                    }
+                }
+                out.push_back(c);
+            }
+            if (m_pos >= m_s.size()) return false;
+            ++m_pos; // closing quote
+            return true;
+        }
+
+        bool value(JsonValue& out) {
+            skipSpace();
+            if (m_pos >= m_s.size()) return false;
+            const char c = m_s[m_pos];
+
+            if (c == '{') {
+                out.type = JsonValue::Type::Object;
+                ++m_pos;
+                skipSpace();
+                if (m_pos < m_s.size() && m_s[m_pos] == '}') { ++m_pos; return true; }
+                while (true) {
+                    skipSpace();
+                    std::string key;
+                    if (m_pos >= m_s.size() || !string(key)) return false;
+                    skipSpace();
+                    if (m_pos >= m_s.size() || m_s[m_pos++] != ':') return false;
+                    JsonValue v;
+                    if (!value(v)) return false;
+                    out.object.emplace_back(std::move(key), std::move(v));
+                    skipSpace();
+                    if (m_pos >= m_s.size()) return false;
+                    if (m_s[m_pos] == ',') { ++m_pos; continue; }
+                    if (m_s[m_pos] == '}') { ++m_pos; return true; }
+                    return false;
+                }
+            }
+            if (c == '[') {
+                out.type = JsonValue::Type::Array;
+                ++m_pos;
+                skipSpace();
+                if (m_pos < m_s.size() && m_s[m_pos] == ']') { ++m_pos; return true; }
+                while (true) {
+                    JsonValue v;
+                    if (!value(v)) return false;
+                    out.array.push_back(std::move(v));
+                    skipSpace();
+                    if (m_pos >= m_s.size()) return false;
+                    if (m_s[m_pos] == ',') { ++m_pos; continue; }
+                    if (m_s[m_pos] == ']') { ++m_pos; return true; }
+                    return false;
+                }
+            }
+            if (c == '"') {
+                out.type = JsonValue::Type::String;
+                return string(out.string);
+            }
+            if (literal("true")) { out.type = JsonValue::Type::Bool; out.boolean = true; return true; }
+            if (literal("false")) { out.type = JsonValue::Type::Bool; out.boolean = false; return true; }
+            if (literal("null")) { out.type = JsonValue::Type::Null; return true; }
+
+            // Number
+            const char* begin = m_s.c_str() + m_pos;
+            char* end = nullptr;
+            out.number = std::strtod(begin, &end);
+            if (end == begin) return false;
+            out.type = JsonValue::Type::Number;
+            m_pos += static_cast<std::size_t>(end - begin);
+            return true;
+        }
+
+    private:
+        const std::string& m_s;
+        std::size_t m_pos = 0;
+    };
+
+    // "run2" sorts before "run10"
+    bool naturalLess(const std::string& a, const std::string& b)
+    {
+        std::size_t i = 0, j = 0;
+        while (i < a.size() && j < b.size()) {
+            if (std::isdigit(static_cast<unsigned char>(a[i])) && std::isdigit(static_cast<unsigned char>(b[j]))) {
+                std::size_t ie = i, je = j;
+                while (ie < a.size() && std::isdigit(static_cast<unsigned char>(a[ie]))) ++ie;
+                while (je < b.size() && std::isdigit(static_cast<unsigned char>(b[je]))) ++je;
+                // Compared as digit strings, so runs of any length never overflow:
+                // without leading zeros the shorter run is the smaller number
+                std::size_t is = i, js = j;
+                while (is + 1 < ie && a[is] == '0') ++is;
+                while (js + 1 < je && b[js] == '0') ++js;
+                if (ie - is != je - js) return ie - is < je - js;
+                const int order = a.compare(is, ie - is, b, js, je - js);
+                if (order != 0) return order < 0;
+                i = ie; j = je;
+            }
+            else {
+                if (a[i] != b[j]) return a[i] < b[j];
+                ++i; ++j;
+            }
+        }
+        if (a.size() - i != b.size() - j) return a.size() - i < b.size() - j;
+        // Same numbers written with different zero padding ("run01", "run1"):
+        // still distinct names, so fall back to plain order rather than equal
+        return a < b;
+    }
+
+    bool frameFromJson(const JsonValue& entry, AnimationFrame& out)
+    {
+        const JsonValue* frame = entry.Get("frame");
+        if (!frame || frame->type != JsonValue::Type::Object) return false;
+
+        const JsonValue* rotated = entry.Get("rotated");
+        if (rotated && rotated->type == JsonValue::Type::Bool && rotated->boolean) {
+            std::cerr << "Warning: rotated sheet frames are not supported\n";
+            return false;
+        }
+
+        out.rect = sf::IntRect(
+            static_cast<int>(frame->Num("x")), static_cast<int>(frame->Num("y")),
+            static_cast<int>(frame->Num("w")), static_cast<int>(frame->Num("h")));
+
+        // Pivot is normalised to the untrimmed source size; convert to trimmed-rect pixels
+        sf::Vector2f source(static_cast<float>(out.rect.width), static_cast<float>(out.rect.height));
+        sf::Vector2f trimOffset(0.f, 0.f);
+        if (const JsonValue* ss = entry.Get("sourceSize"))
+            source = sf::Vector2f(ss->Num("w", source.x), ss->Num("h", source.y));
+        if (const JsonValue* sss = entry.Get("spriteSourceSize"))
+            trimOffset = sf::Vector2f(sss->Num("x"), sss->Num("y"));
+
+        sf::Vector2f pivot(0.5f, 0.5f);
+        if (const JsonValue* p = entry.Get("pivot"))
+            pivot = sf::Vector2f(p->Num("x", 0.5f), p->Num("y", 0.5f));
+
+        out.pivot = sf::Vector2f(pivot.x * source.x - trimOffset.x, pivot.y * source.y - trimOffset.y);
+        return true;
+    }
+}
+
+namespace SpriteSheet {
+
+    bool PackImages(const std::vector<const sf::Image*>& images,
+        std::vector<std::shared_ptr<const sf::Texture>>& pages,
+        std::vector<AnimationFrame>& frames, bool mipmap)
+    {
+        pages.clear();
+        frames.assign(images.size(), AnimationFrame());
+        if (images.empty()) return true;
+
+        const unsigned maxSize = std::min(sf::Texture::getMaximumSize(), PAGE_LIMIT);
+
+        // Page width: roughly square for the total area, never narrower than the widest frame
+        unsigned widest = 0;
+        double area = 0.0;
+        for (const sf::Image* img : images) {
+            const sf::Vector2u sz = img->getSize();
+            if (sz.x + PADDING > maxSize || sz.y + PADDING > maxSize) {
+                std::cerr << "Warning: frame " << sz.x << "x" << sz.y << " does not fit a " << maxSize << " sheet page\n";
+                return false;
+            }
+            widest = std::max(widest, sz.x + PADDING);
+            area += static_cast<double>(sz.x + PADDING) * (sz.y + PADDING);
+        }
+        const unsigned pageWidth = std::min(maxSize,
+            std::max(widest, static_cast<unsigned>(std::ceil(std::sqrt(area)))));
+
+        // Shelf packing, tallest first, so pages fill densely
+        std::vector<std::size_t> order(images.size());
+        for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return images[a]->getSize().y > images[b]->getSize().y;
+        });
+
+        struct Placement { std::size_t image; unsigned x, y; };
+        std::vector<std::vector<Placement>> pagePlacements(1);
+        std::vector<unsigned> pageHeights(1, 0);
+        unsigned x = 0, y = 0, shelf = 0;
+
+        for (std::size_t idx : order) {
+            const sf::Vector2u sz = images[idx]->getSize();
+            const unsigned w = sz.x + PADDING, h = sz.y + PADDING;
+            if (x + w > pageWidth) { // next shelf
+                x = 0;
+                y += shelf;
+                shelf = 0;
+            }
+            if (y + h > maxSize) { // next page
+                pagePlacements.emplace_back();
+                pageHeights.push_back(0);
+                x = 0; y = 0; shelf = 0;
+            }
+            pagePlacements.back().push_back({ idx, x, y });
+            pageHeights.back() = std::max(pageHeights.back(), y + h);
+            x += w;
+            shelf = std::max(shelf, h);
+        }
+
+        for (std::size_t p = 0; p < pagePlacements.size(); ++p) {
+            sf::Image sheet;
+            sheet.create(pageWidth, pageHeights[p], sf::Color::Transparent);
+            for (const Placement& pl : pagePlacements[p]) {
+                const sf::Image& img = *images[pl.image];
+                sheet.copy(img, pl.x, pl.y);
+
+                AnimationFrame& f = frames[pl.image];
+                f.page = static_cast<std::uint16_t>(p);
+                f.rect = sf::IntRect(static_cast<int>(pl.x), static_cast<int>(pl.y),
+                    static_cast<int>(img.getSize().x), static_cast<int>(img.getSize().y));
+                f.pivot = sf::Vector2f(img.getSize().x * 0.5f, img.getSize().y * 0.5f);
+            }
+
+            auto tex = std::make_shared<sf::Texture>();
+            if (!tex->loadFromImage(sheet)) {
+                std::cerr << "Warning: failed to upload packed sheet page\n";
+                pages.clear();
+                return false;
+            }
+            tex->setSmooth(true);
+            if (mipmap && !tex->generateMipmap())
+                std::cerr << "Warning: mipmaps unavailable for packed sheet page\n";
+            pages.push_back(std::move(tex));
+        }
+        return true;
+    }
+
+    bool GridFrames(const sf::Vector2u& sheetSize, const sf::Vector2i& frameSize,
+        int firstFrame, int frameCount, std::vector<AnimationFrame>& frames)
+    {
+        frames.clear();
+        if (frameSize.x <= 0 || frameSize.y <= 0 || firstFrame < 0 || frameCount <= 0) return false;
+
+        const int cols = static_cast<int>(sheetSize.x) / frameSize.x;
+        const int rows = static_cast<int>(sheetSize.y) / frameSize.y;
+        if (cols == 0 || firstFrame + frameCount > cols * rows) {
+            std::cerr << "Warning: sheet grid has fewer cells than requested frames\n";
+            return false;
+        }
+
+        frames.reserve(frameCount);
+        for (int i = firstFrame; i < firstFrame + frameCount; ++i) {
+            AnimationFrame f;
+            f.rect = sf::IntRect((i % cols) * frameSize.x, (i / cols) * frameSize.y, frameSize.x, frameSize.y);
+            f.pivot = sf::Vector2f(frameSize.x * 0.5f, frameSize.y * 0.5f);
+            frames.push_back(f);
+        }
+        return true;
+    }
+
+    bool ParseJson(const std::string& jsonPath, const std::string& prefix,
+        std::string& imagePath, std::vector<AnimationFrame>& frames)
+    {
+        frames.clear();
+
+        std::ifstream in(jsonPath, std::ios::binary);
+        if (!in) {
+            std::cerr << "Warning: failed to open sheet descriptor " << jsonPath << "\n";
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        const std::string text = buffer.str();
+
+        JsonValue root;
+        if (!JsonParser(text).Parse(root) || root.type != JsonValue::Type::Object) {
+            std::cerr << "Warning: malformed sheet descriptor " << jsonPath << "\n";
+            return false;
+        }
+
+        // Collect name -> entry from either layout
+        std::map<std::string, const JsonValue*, bool(*)(const std::string&, const std::string&)> named(naturalLess);
+        if (const JsonValue* list = root.Get("frames")) {
+            if (list->type == JsonValue::Type::Object) {
+                for (const auto& kv : list->object)
+                    if (kv.first.compare(0, prefix.size(), prefix) == 0) named[kv.first] = &kv.second;
+            }
+            else if (list->type == JsonValue::Type::Array) {
+                for (const auto& entry : list->array) {
+                    const JsonValue* name = entry.Get("filename");
+                    if (name && name->type == JsonValue::Type::String && name->string.compare(0, prefix.size(), prefix) == 0)
+                        named[name->string] = &entry;
+                }
+            }
+        }
+
+        for (const auto& kv : named) {
+            AnimationFrame f;
+            if (!frameFromJson(*kv.second, f)) return false;
+            frames.push_back(f);
+        }
+        if (frames.empty()) {
+            std::cerr << "Warning: no frames named '" << prefix << "*' in " << jsonPath << "\n";
+            return false;
+        }
+
+        imagePath.clear();
+        if (const JsonValue* meta = root.Get("meta"))
+            if (const JsonValue* image = meta->Get("image"))
+                imagePath = image->string;
+        if (imagePath.empty()) {
+            std::cerr << "Warning: sheet descriptor has no meta.image: " << jsonPath << "\n";
+            return false;
+        }
+        const std::size_t slash = jsonPath.find_last_of("/\\");
+        if (slash != std::string::npos) imagePath = jsonPath.substr(0, slash + 1) + imagePath;
+        return true;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One animation frame: a rectangle on a sheet page and the pivot (in
+// pixels, relative to the rectangle) the sprite origin is placed on.
+struct AnimationFrame {
+    std::uint16_t page = 0;
+    sf::IntRect rect;
+    sf::Vector2f pivot;
+};
+
+// Load-time helpers that turn images and sheet descriptors into frames.
+namespace SpriteSheet {
+
+    // Pack separate frame images into as few sheet pages as the GPU's
+    // maximum texture size allows. Frames keep the input order and pivot
+    // on their centre. Returns false if an image is larger than one page.
+    bool PackImages(const std::vector<const sf::Image*>& images,
+        std::vector<std::shared_ptr<const sf::Texture>>& pages,
+        std::vector<AnimationFrame>& frames, bool mipmap = false);
+
+    // Uniform grid, frames numbered row-major from the top-left cell.
+    bool GridFrames(const sf::Vector2u& sheetSize, const sf::Vector2i& frameSize,
+        int firstFrame, int frameCount, std::vector<AnimationFrame>& frames);
+
+    // TexturePacker-style JSON (hash or array form). Picks the frames whose
+    // name starts with `prefix`, in natural name order ("run2" < "run10").
+    // Trimmed frames and normalised "pivot" entries are honoured; rotated
+    // frames are not supported. `imagePath` receives meta.image resolved
+    // against the descriptor's directory.
+    bool ParseJson(const std::string& jsonPath, const std::string& prefix,
+        std::string& imagePath, std::vector<AnimationFrame>& frames);
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Bounded single-producer / single-consumer ring buffer. One thread may
+// call TryPush and one other thread TryPop; neither ever blocks or
+// allocates. Capacity must be a power of two.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+    // Producer. False when the queue is full.
+    bool TryPush(const T& item)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == Capacity) return false;
+        m_items[head & MASK] = item;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer. False when the queue is empty.
+    bool TryPop(T& out)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) return false;
+        // Moved out, so a slot doesn't keep what it carried alive until reuse
+        out = std::move(m_items[tail & MASK]);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate from any thread other than the two ends
+    bool Empty() const { return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire); }
+
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+
+    // Each end gets its own cache line so they don't false-share
+    alignas(64) std::atomic<std::size_t> m_head{ 0 }; // next slot to write
+    alignas(64) std::atomic<std::size_t> m_tail{ 0 }; // next slot to read
+    alignas(64) std::array<T, Capacity> m_items{};
+};
@@ -0,0 +1,145 @@
+#include "StaticGeometry.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+static sf::FloatRect unite(const sf::FloatRect& a, const sf::FloatRect& b)
+{
+    const float left = std::min(a.left, b.left);
+    const float top = std::min(a.top, b.top);
+    const float right = std::max(a.left + a.width, b.left + b.width);
+    const float bottom = std::max(a.top + a.height, b.top + b.height);
+    return sf::FloatRect(left, top, right - left, bottom - top);
+}
+
+void StaticGeometry::Clear()
+{
+    m_sections.clear();
+}
+
+StaticGeometry::Section& StaticGeometry::sectionFor(int index)
+{
+    auto it = std::lower_bound(m_sections.begin(), m_sections.end(), index,
+        [](const Section& s, int i) { return s.index < i; });
+    if (it == m_sections.end() || it->index != index) {
+        it = m_sections.emplace(it);
+        it->index = index;
+    }
+    return *it;
+}
+
+void StaticGeometry::Add(std::size_t key, const sf::RectangleShape& shape)
+{
+    Prop prop;
+    prop.key = key;
+    prop.texture = shape.getTexture();
+    prop.bounds = shape.getGlobalBounds();
+
+    const sf::Transform& xf = shape.getTransform();
+    const sf::Vector2f size = shape.getSize();
+    const sf::IntRect tr = shape.getTextureRect();
+    const sf::Color color = shape.getFillColor();
+
+    const sf::Vector2f pos[4] = {
+        xf.transformPoint(0.f, 0.f), xf.transformPoint(size.x, 0.f),
+        xf.transformPoint(size.x, size.y), xf.transformPoint(0.f, size.y) };
+    const float u0 = static_cast<float>(tr.left), v0 = static_cast<float>(tr.top);
+    const float u1 = static_cast<float>(tr.left + tr.width), v1 = static_cast<float>(tr.top + tr.height);
+    const sf::Vector2f uv[4] = { { u0, v0 }, { u1, v0 }, { u1, v1 }, { u0, v1 } };
+
+    static const int order[6] = { 0, 1, 2, 0, 2, 3 };
+    for (int i = 0; i < 6; ++i)
+        prop.quad[i] = sf::Vertex(pos[order[i]], color, uv[order[i]]);
+
+    const float centerX = prop.bounds.left + prop.bounds.width * 0.5f;
+    Section& section = sectionFor(static_cast<int>(std::floor(centerX / SECTION_WIDTH)));
+    section.props.push_back(prop);
+    section.dirty = true;
+}
+
+void StaticGeometry::Remove(std::size_t key)
+{
+    for (auto& section : m_sections) {
+        auto it = std::find_if(section.props.begin(), section.props.end(),
+            [key](const Prop& p) { return p.key == key; });
+        if (it != section.props.end()) {
+            section.props.erase(it);
+            section.dirty = true;
+            return;
+        }
+    }
+}
+
+bool StaticGeometry::Contains(std::size_t key) const
+{
+    for (const auto& section : m_sections)
+        for (const auto& p : section.props)
+            if (p.key == key) return true;
+    return false;
+}
+
+std::size_t StaticGeometry::PropCount() const
+{
+    std::size_t n = 0;
+    for (const auto& section : m_sections) n += section.props.size();
+    return n;
+}
+
+void StaticGeometry::rebuild(Section& section)
+{
+    section.dirty = false;
+    section.runs.clear();
+    section.fallback.clear();
+    section.bounds = sf::FloatRect();
+
+    std::vector<sf::Vertex> vertices;
+    vertices.reserve(section.props.size() * 6);
+    for (std::size_t i = 0; i < section.props.size(); ++i) {
+        const Prop& p = section.props[i];
+        if (section.runs.empty() || section.runs.back().texture != p.texture)
+            section.runs.push_back({ p.texture, vertices.size(), 0 });
+        section.runs.back().count += 6;
+        vertices.insert(vertices.end(), p.quad, p.quad + 6);
+        section.bounds = (i == 0) ? p.bounds : unite(section.bounds, p.bounds);
+    }
+
+    section.useBuffer = false;
+    if (vertices.empty()) return;
+
+    if (sf::VertexBuffer::isAvailable()) {
+        section.useBuffer = section.buffer.create(vertices.size()) && section.buffer.update(vertices.data());
+        if (!section.useBuffer)
+            std::cerr << "Warning: static geometry upload failed, using client-side vertices\n";
+    }
+    if (!section.useBuffer) {
+        for (const auto& v : vertices) section.fallback.append(v);
+    }
+}
+
+void StaticGeometry::Draw(Renderer& renderer, const sf::FloatRect& visible, std::size_t firstKey, std::size_t endKey)
+{
+    const auto byKey = [](const Prop& p, std::size_t key) { return p.key < key; };
+    for (auto& section : m_sections) {
+        if (section.dirty) rebuild(section);
+        if (section.runs.empty() || !section.bounds.intersects(visible)) continue;
+
+        // Props are sorted by key, so the range is one stretch of vertices
+        const auto begin = std::lower_bound(section.props.begin(), section.props.end(), firstKey, byKey);
+        const auto end = std::lower_bound(begin, section.props.end(), endKey, byKey);
+        if (begin == end) continue;
+        const std::size_t from = static_cast<std::size_t>(begin - section.props.begin()) * 6;
+        const std::size_t to = static_cast<std::size_t>(end - section.props.begin()) * 6;
+
+        for (const Run& run : section.runs) {
+            const std::size_t first = std::max(run.first, from);
+            const std::size_t last = std::min(run.first + run.count, to);
+            if (first >= last) continue;
+            sf::RenderStates states;
+            states.texture = run.texture;
+            if (section.useBuffer)
+                renderer.Draw(section.buffer, first, last - first, states);
+            else
+                renderer.Draw(&section.fallback[first], last - first, sf::Triangles, states);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+#include "Renderer.h"
+
+// Bakes props that never move into one static vertex buffer per level
+// section, uploaded once and drawn as one call per texture run.
+// Props keep their submission order inside a section so overlapping
+// decoration still layers the same way; keys must be added in increasing
+// order. Removing a prop (e.g. because its
+// body turned dynamic) only re-uploads the section it belonged to.
+class StaticGeometry {
+public:
+    static constexpr float SECTION_WIDTH = 1920.f;
+
+    void Clear();
+
+    // Bake the shape's current transform, texture rect and fill colour.
+    // `key` identifies the prop for Remove()/Contains().
+    void Add(std::size_t key, const sf::RectangleShape& shape);
+    void Remove(std::size_t key);
+    bool Contains(std::size_t key) const;
+
+    // Draw the props keyed [firstKey, endKey) in sections overlapping
+    // `visible`, so callers can interleave other draws in key order. Dirty
+    // sections are re-uploaded first.
+    void Draw(Renderer& renderer, const sf::FloatRect& visible,
+        std::size_t firstKey = 0, std::size_t endKey = static_cast<std::size_t>(-1));
+
+    std::size_t PropCount() const;
+    std::size_t SectionCount() const { return m_sections.size(); }
+    bool UsesVertexBuffers() const { return sf::VertexBuffer::isAvailable(); }
+
+private:
+    struct Prop {
+        std::size_t key = 0;
+        const sf::Texture* texture = nullptr;
+        sf::Vertex quad[6];
+        sf::FloatRect bounds;
+    };
+
+    // Consecutive props sharing a texture
+    struct Run {
+        const sf::Texture* texture = nullptr;
+        std::size_t first = 0;
+        std::size_t count = 0;
+    };
+
+    struct Section {
+        int index = 0;
+        std::vector<Prop> props;
+        std::vector<Run> runs;
+        sf::VertexBuffer buffer{ sf::Triangles, sf::VertexBuffer::Static };
+        sf::VertexArray fallback{ sf::Triangles }; // used when vertex buffers are unsupported
+        bool useBuffer = false;
+        sf::FloatRect bounds;
+        bool dirty = true;
+    };
+
+    Section& sectionFor(int index);
+    void rebuild(Section& section);
+
+private:
+    std::vector<Section> m_sections; // sorted by index
+};
@@ -0,0 +1,150 @@
+#include "TextureBaker.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+    constexpr float LANCZOS_RADIUS = 3.f;
+    constexpr float BAKE_STEP = 32.f; // bake scales are multiples of 1/32
+    constexpr float PI = 3.14159265358979f;
+
+    float lanczos(float x)
+    {
+        x = std::abs(x);
+        if (x < 1e-5f) return 1.f;
+        if (x >= LANCZOS_RADIUS) return 0.f;
+        const float px = PI * x;
+        return LANCZOS_RADIUS * std::sin(px) * std::sin(px / LANCZOS_RADIUS) / (px * px);
+    }
+
+    // Source taps and normalised weights for one destination row or column
+    struct Taps {
+        int first = 0;
+        std::vector<float> weights;
+    };
+
+    std::vector<Taps> buildTaps(unsigned srcSize, unsigned dstSize)
+    {
+        const float scale = static_cast<float>(dstSize) / static_cast<float>(srcSize);
+        const float filterScale = std::min(scale, 1.f);     // widen the kernel when shrinking
+        const float support = LANCZOS_RADIUS / filterScale;
+
+        std::vector<Taps> taps(dstSize);
+        for (unsigned i = 0; i < dstSize; ++i) {
+            const float centre = (static_cast<float>(i) + 0.5f) / scale;
+            const int first = std::max(0, static_cast<int>(std::floor(centre - support)));
+            const int last = std::min(static_cast<int>(srcSize) - 1, static_cast<int>(std::ceil(centre + support)));
+
+            Taps& t = taps[i];
+            t.first = first;
+            float sum = 0.f;
+            for (int j = first; j <= last; ++j) {
+                const float w = lanczos((static_cast<float>(j) + 0.5f - centre) * filterScale);
+                t.weights.push_back(w);
+                sum += w;
+            }
+            if (sum != 0.f)
+                for (float& w : t.weights) w /= sum;
+        }
+        return taps;
+    }
+
+    sf::Uint8 toByte(float v)
+    {
+        return static_cast<sf::Uint8>(std::clamp(v, 0.f, 255.f) + 0.5f);
+    }
+}
+
+TextureBaker& TextureBaker::Shared()
+{
+    static TextureBaker baker;
+    return baker;
+}
+
+void TextureBaker::SetTarget(const sf::Vector2f& viewSize, const sf::Vector2u& outputSize)
+{
+    if (viewSize.x <= 0.f || viewSize.y <= 0.f) return;
+    m_pixelsPerUnit = sf::Vector2f(static_cast<float>(outputSize.x) / viewSize.x,
+        static_cast<float>(outputSize.y) / viewSize.y);
+}
+
+float TextureBaker::BakeScale(float drawScale) const
+{
+    if (!m_enabled || drawScale <= 0.f) return 1.f;
+
+    // A stretched view is sampled hardest along the axis with more pixels
+    const float onScreen = drawScale * std::max(m_pixelsPerUnit.x, m_pixelsPerUnit.y) * m_headroom;
+    const float stepped = std::ceil(onScreen * BAKE_STEP - 1e-3f) / BAKE_STEP;
+    return std::clamp(stepped, 1.f / BAKE_STEP, 1.f);
+}
+
+bool TextureBaker::Resample(const sf::Image& src, float scale, sf::Image& dst)
+{
+    const sf::Vector2u srcSize = src.getSize();
+    if (srcSize.x == 0 || srcSize.y == 0) return false;
+
+    const unsigned dstW = std::max(1u, static_cast<unsigned>(std::lround(srcSize.x * scale)));
+    const unsigned dstH = std::max(1u, static_cast<unsigned>(std::lround(srcSize.y * scale)));
+    if (dstW == srcSize.x && dstH == srcSize.y) {
+        dst = src;
+        return true;
+    }
+
+    // Premultiply into floats so colour under transparent texels has no weight
+    const sf::Uint8* in = src.getPixelsPtr();
+    std::vector<float> pre(static_cast<std::size_t>(srcSize.x) * srcSize.y * 4);
+    for (std::size_t i = 0; i < pre.size(); i += 4) {
+        const float a = in[i + 3] * (1.f / 255.f);
+        pre[i + 0] = in[i + 0] * a;
+        pre[i + 1] = in[i + 1] * a;
+        pre[i + 2] = in[i + 2] * a;
+        pre[i + 3] = static_cast<float>(in[i + 3]);
+    }
+
+    // Horizontal pass: srcH rows of dstW texels
+    const std::vector<Taps> columns = buildTaps(srcSize.x, dstW);
+    std::vector<float> horiz(static_cast<std::size_t>(dstW) * srcSize.y * 4);
+    for (unsigned y = 0; y < srcSize.y; ++y) {
+        const float* row = &pre[static_cast<std::size_t>(y) * srcSize.x * 4];
+        float* out = &horiz[static_cast<std::size_t>(y) * dstW * 4];
+        for (unsigned x = 0; x < dstW; ++x) {
+            const Taps& t = columns[x];
+            float acc[4] = { 0.f, 0.f, 0.f, 0.f };
+            for (std::size_t k = 0; k < t.weights.size(); ++k) {
+                const float* p = row + (static_cast<std::size_t>(t.first) + k) * 4;
+                const float w = t.weights[k];
+                acc[0] += p[0] * w; acc[1] += p[1] * w; acc[2] += p[2] * w; acc[3] += p[3] * w;
+            }
+            std::copy(acc, acc + 4, out + static_cast<std::size_t>(x) * 4);
+        }
+    }
+
+    // Vertical pass, then back to straight alpha
+    const std::vector<Taps> rows = buildTaps(srcSize.y, dstH);
+    std::vector<sf::Uint8> pixels(static_cast<std::size_t>(dstW) * dstH * 4);
+    std::vector<float> acc(static_cast<std::size_t>(dstW) * 4);
+    for (unsigned y = 0; y < dstH; ++y) {
+        const Taps& t = rows[y];
+        std::fill(acc.begin(), acc.end(), 0.f);
+        for (std::size_t k = 0; k < t.weights.size(); ++k) {
+            const float* row = &horiz[(static_cast<std::size_t>(t.first) + k) * dstW * 4];
+            const float w = t.weights[k];
+            for (std::size_t i = 0; i < acc.size(); ++i) acc[i] += row[i] * w;
+        }
+
+        sf::Uint8* out = &pixels[static_cast<std::size_t>(y) * dstW * 4];
+        for (std::size_t i = 0; i < acc.size(); i += 4) {
+            const float a = std::clamp(acc[i + 3], 0.f, 255.f);
+            const float unpremultiply = a > 0.5f ? 1.f / (a * (1.f / 255.f)) : 0.f;
+            out[i + 0] = toByte(acc[i + 0] * unpremultiply);
+            out[i + 1] = toByte(acc[i + 1] * unpremultiply);
+            out[i + 2] = toByte(acc[i + 2] * unpremultiply);
+            out[i + 3] = toByte(a);
+        }
+    }
+
+    dst.create(dstW, dstH, pixels.data());
+    return true;
+}
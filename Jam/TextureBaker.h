@@ -0,0 +1,47 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+// Resamples sprite art to the size it is actually drawn at. A sprite
+// drawn at 0.33 scale only needs a third of its source resolution, so
+// its frames are baked down once at load time (texture memory and
+// sampling bandwidth drop with the square of the scale) and the sprite
+// is drawn at SpriteScale() instead of its nominal scale.
+//
+// Configure with SetTarget before loading starts; BakeScale is read from
+// loader threads and must give the same answer for the whole load.
+class TextureBaker {
+public:
+    static TextureBaker& Shared();
+
+    // World view size (world units) and the pixel size it is presented at
+    void SetTarget(const sf::Vector2f& viewSize, const sf::Vector2u& outputSize);
+    void SetEnabled(bool enabled) { m_enabled = enabled; }
+    bool IsEnabled() const { return m_enabled; }
+
+    // Extra resolution kept above the exact on-screen size, for
+    // sub-pixel motion and small zooms
+    void SetHeadroom(float headroom) { m_headroom = headroom; }
+
+    // Mipmapped sheet pages for baked clips. Off by default: bakes already
+    // match screen size, and lower levels blend across the 2px page padding
+    void SetMipmaps(bool mipmaps) { m_mipmaps = mipmaps; }
+    bool Mipmaps() const { return m_mipmaps; }
+
+    // Texels per source pixel for art drawn at `drawScale` world units per
+    // source pixel. In (0, 1], rounded up to 1/32 steps so nearby scales
+    // share one bake. 1 means "load as is".
+    float BakeScale(float drawScale) const;
+
+    // Sprite scale that draws a bake of BakeScale(drawScale) at drawScale
+    float SpriteScale(float drawScale) const { return drawScale / BakeScale(drawScale); }
+
+    // Separable Lanczos-3 in premultiplied alpha, so transparent texels
+    // never darken the edges. Returns false if `src` is empty.
+    static bool Resample(const sf::Image& src, float scale, sf::Image& dst);
+
+private:
+    sf::Vector2f m_pixelsPerUnit{ 1.f, 1.f };
+    float m_headroom = 1.f;
+    bool m_enabled = true;
+    bool m_mipmaps = false;
+};
@@ -0,0 +1,201 @@
+#include "VoicePool.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    // Voices already playing win ties against waiting instances, so two
+    // sounds at nearly the same distance do not trade a voice every frame
+    constexpr float KEEP_BONUS = 0.05f;
+}
+
+VoicePool::VoicePool(unsigned capacity)
+    : m_slots(std::max(1u, capacity))
+    , m_soundCapacity(std::max(1u, capacity))
+{
+    // Ambience and music-like loops are few; one-shots get most of the pool
+    SetCategoryLimit(AudioCategory::Music, 2);
+    SetCategoryLimit(AudioCategory::Background, 6);
+    SetCategoryLimit(AudioCategory::Dialogue, 8);
+    SetCategoryLimit(AudioCategory::Effects, capacity);
+}
+
+VoicePool::~VoicePool() = default;
+
+void VoicePool::UseMixer(SoftwareMixer* mixer)
+{
+    if (m_active > 0) {
+        std::cerr << "Warning: voice pool backend cannot change while voices are playing" << std::endl;
+        return;
+    }
+    m_mixer = mixer;
+    const unsigned capacity = mixer ? mixer->VoiceCount() : m_soundCapacity;
+    m_slots.clear();
+    m_slots.resize(capacity);
+    SetCategoryLimit(AudioCategory::Effects, capacity);
+}
+
+void VoicePool::SetCategoryLimit(AudioCategory category, unsigned limit)
+{
+    m_categoryLimits[index(category)] = limit;
+}
+
+bool VoicePool::hasRoom(AudioCategory category) const
+{
+    return m_active < m_slots.size() && m_categoryVoices[index(category)] < m_categoryLimits[index(category)];
+}
+
+int VoicePool::freeSlot() const
+{
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+        if (!m_slots[i].used) return static_cast<int>(i);
+    return -1;
+}
+
+void VoicePool::bind(AudioEmitter& emitter, EmitterInstance& instance, int slot)
+{
+    Slot& s = m_slots[static_cast<std::size_t>(slot)];
+    s.used = true;
+    s.category = emitter.category;
+    ++m_active;
+    ++m_categoryVoices[index(emitter.category)];
+    s.volume = emitter.finalVolume * 100.f;
+    s.pan = emitter.pan;
+    instance.voice = slot;
+
+    if (m_mixer) {
+        m_mixer->Start(slot, emitter.category, emitter.buffer, emitter.loop, instance.position, emitter.finalVolume,
+            emitter.pan, emitter.pitch, instance.paused || emitter.busPaused);
+        return;
+    }
+
+    if (!s.sound) {
+        // Attenuation is ours (AudioManager); OpenAL only pans. Sources sit on a
+        // unit circle in front of a listener that never moves.
+        s.sound = std::make_unique<sf::Sound>();
+        s.sound->setRelativeToListener(true);
+        s.sound->setAttenuation(0.f);
+    }
+    sf::Sound& sound = *s.sound;
+    sound.setBuffer(*emitter.buffer);
+    sound.setLoop(emitter.loop);
+    sound.setPitch(emitter.pitch);
+    sound.setVolume(s.volume);
+    applyPan(s, emitter.pan);
+    sound.play();
+    // Instances that ran virtually pick up where they would have been
+    if (instance.position > sf::Time::Zero) sound.setPlayingOffset(instance.position);
+    if (instance.paused || emitter.busPaused) sound.pause();
+}
+
+void VoicePool::applyPan(Slot& slot, float pan)
+{
+    // Only mono buffers are spatialised by OpenAL; stereo ones play as authored
+    slot.pan = pan;
+    slot.sound->setPosition(pan, 0.f, -std::sqrt(std::max(0.f, 1.f - pan * pan)));
+}
+
+bool VoicePool::TryBind(AudioEmitter& emitter, EmitterInstance& instance)
+{
+    if (instance.voice >= 0) return true;
+    if (!emitter.buffer || emitter.finalVolume <= AUDIBLE_VOLUME || !hasRoom(emitter.category)) return false;
+    const int slot = freeSlot();
+    if (slot < 0) return false;
+    bind(emitter, instance, slot);
+    return true;
+}
+
+void VoicePool::Release(EmitterInstance& instance)
+{
+    if (instance.voice < 0) return;
+    Slot& s = m_slots[static_cast<std::size_t>(instance.voice)];
+    if (m_mixer) m_mixer->Stop(instance.voice);
+    else s.sound->resetBuffer(); // stops it too, and leaves nothing attached to a buffer the SoundBank may evict
+    s.used = false;
+    --m_active;
+    --m_categoryVoices[index(s.category)];
+    instance.voice = -1;
+}
+
+void VoicePool::PauseVoice(int slot)
+{
+    if (m_mixer) m_mixer->SetPaused(slot, true);
+    else m_slots[static_cast<std::size_t>(slot)].sound->pause();
+}
+
+void VoicePool::ResumeVoice(int slot)
+{
+    if (m_mixer) m_mixer->SetPaused(slot, false);
+    else m_slots[static_cast<std::size_t>(slot)].sound->play();
+}
+
+bool VoicePool::IsFinished(int slot) const
+{
+    if (m_mixer) return m_mixer->IsFinished(slot);
+    return m_slots[static_cast<std::size_t>(slot)].sound->getStatus() == sf::Sound::Stopped;
+}
+
+void VoicePool::Update(const std::vector<AudioEmitter*>& emitters)
+{
+    // Candidates are every audible instance; inaudible ones give their voice back now
+    std::vector<Candidate>& candidates = m_candidates;
+    candidates.clear();
+    for (AudioEmitter* e : emitters) {
+        const bool audible = e->buffer && e->finalVolume > AUDIBLE_VOLUME;
+        for (EmitterInstance& inst : e->instances) {
+            if (!audible) {
+                Release(inst);
+                continue;
+            }
+            if ((inst.paused || e->busPaused) && inst.voice < 0) continue; // nothing to hear until resumed
+            const float score = static_cast<float>(e->priority) + e->finalVolume + (inst.voice >= 0 ? KEEP_BONUS : 0.f);
+            candidates.push_back({ e, &inst, score });
+        }
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(),
+        [](const Candidate& a, const Candidate& b) { return a.score > b.score; });
+
+    // Walk in order of importance; everything that no longer fits loses its voice first
+    std::array<unsigned, AUDIO_CATEGORY_COUNT> granted{};
+    std::size_t total = 0;
+    std::size_t cut = 0;
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        Candidate& c = candidates[i];
+        const std::size_t cat = index(c.emitter->category);
+        if (total < m_slots.size() && granted[cat] < m_categoryLimits[cat]) {
+            ++granted[cat];
+            ++total;
+            std::swap(candidates[cut++], c); // winners gather at the front; c is now a processed loser
+        }
+        else if (c.instance->voice >= 0) {
+            Release(*c.instance);
+            ++m_steals;
+        }
+    }
+
+    for (std::size_t i = 0; i < cut; ++i) {
+        Candidate& c = candidates[i];
+        if (c.instance->voice < 0) {
+            bind(*c.emitter, *c.instance, freeSlot());
+            continue;
+        }
+        Slot& s = m_slots[static_cast<std::size_t>(c.instance->voice)];
+        const float volume = c.emitter->finalVolume * 100.f;
+        const bool volumeChanged = std::abs(volume - s.volume) > VOLUME_EPSILON;
+        const bool panChanged = std::abs(c.emitter->pan - s.pan) > PAN_EPSILON;
+        if (m_mixer) {
+            if (!volumeChanged && !panChanged) continue;
+            s.volume = volume;
+            s.pan = c.emitter->pan;
+            m_mixer->SetGain(c.instance->voice, volume / 100.f, s.pan);
+            continue;
+        }
+        if (volumeChanged) {
+            s.volume = volume;
+            s.sound->setVolume(volume);
+        }
+        if (panChanged)
+            applyPan(s, c.emitter->pan);
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "AudioEmitter.h"
+#include "SoftwareMixer.h"
+
+// Fixed set of voices (an sf::Sound each, or the channels of a
+// SoftwareMixer) shared by every emitter. Emitter
+// instances borrow a voice while they are audible and give it back when
+// they stop, finish or fall out of range. When the global cap or a
+// category's limit is reached, the least important instances (lowest
+// priority, then quietest, i.e. furthest away) lose their voice and keep
+// running virtually until one frees up.
+class VoicePool {
+public:
+    // Below this volume an instance is treated as inaudible
+    static constexpr float AUDIBLE_VOLUME = 0.001f;
+    // Smaller volume changes (sf::Sound's 0..100 scale) are not sent to OpenAL
+    static constexpr float VOLUME_EPSILON = 0.5f;
+    static constexpr float PAN_EPSILON = 0.02f;
+
+    explicit VoicePool(unsigned capacity = 32);
+    ~VoicePool();
+
+    VoicePool(const VoicePool&) = delete;
+    VoicePool& operator=(const VoicePool&) = delete;
+
+    void SetCategoryLimit(AudioCategory category, unsigned limit);
+    unsigned CategoryLimit(AudioCategory category) const { return m_categoryLimits[index(category)]; }
+
+    // Bind a free voice right away if the instance is audible and the
+    // limits allow it; never steals. Update picks up anything left virtual.
+    bool TryBind(AudioEmitter& emitter, EmitterInstance& instance);
+    void Release(EmitterInstance& instance);
+    void PauseVoice(int slot);
+    void ResumeVoice(int slot);
+    bool IsFinished(int slot) const;
+
+    // Play every voice through one software-mixed stream instead of an
+    // sf::Sound each; null goes back to sf::Sound. Only while no voice is
+    // bound. The pool takes the mixer's voice count as its capacity.
+    void UseMixer(SoftwareMixer* mixer);
+    bool SoftwareMixing() const { return m_mixer != nullptr; }
+
+    // Once per frame, after emitter volumes are updated: reassign voices so
+    // the most important audible instances hold them, then push volumes.
+    // Only emitters with instances need to be passed.
+    void Update(const std::vector<AudioEmitter*>& emitters);
+
+    unsigned Capacity() const { return static_cast<unsigned>(m_slots.size()); }
+    // Counters are atomic so the game thread can show them while the audio
+    // thread mixes; everything else belongs to the audio thread
+    unsigned ActiveVoices() const { return m_active.load(std::memory_order_relaxed); }
+    unsigned CategoryVoices(AudioCategory category) const { return m_categoryVoices[index(category)].load(std::memory_order_relaxed); }
+    std::uint64_t Steals() const { return m_steals.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::unique_ptr<sf::Sound> sound; // created on first use; each holds an OpenAL source. Unused when mixing
+        bool used = false;
+        AudioCategory category = AudioCategory::Effects;
+        float volume = 0.f; // last value given to setVolume
+        float pan = 0.f;
+    };
+
+    struct Candidate {
+        AudioEmitter* emitter;
+        EmitterInstance* instance;
+        float score;
+    };
+
+    static std::size_t index(AudioCategory category) { return static_cast<std::size_t>(category); }
+    bool hasRoom(AudioCategory category) const;
+    int freeSlot() const;
+    void bind(AudioEmitter& emitter, EmitterInstance& instance, int slot);
+    static void applyPan(Slot& slot, float pan);
+
+private:
+    std::vector<Slot> m_slots;
+    std::array<unsigned, AUDIO_CATEGORY_COUNT> m_categoryLimits{};
+    std::array<std::atomic<unsigned>, AUDIO_CATEGORY_COUNT> m_categoryVoices{};
+    std::atomic<unsigned> m_active{ 0 };
+    std::atomic<std::uint64_t> m_steals{ 0 };
+    std::vector<Candidate> m_candidates; // reused every Update
+    SoftwareMixer* m_mixer = nullptr;
+    unsigned m_soundCapacity; // capacity when playing through sf::Sound
+};
@@ -1,62 +1,61 @@
 ﻿#include "World.h"
 #include "AudioEmitter.h" // kept from first version (safe if present)
+#include "ResourceCache.h"
+#include "AsyncLoader.h"
+#include "TextureBaker.h"
+#include <iterator>
 #include <iostream>
 
 #include <SFML/Graphics.hpp>
 constexpr float PPM = 30.f; // Pixels per meter
 constexpr float INV_PPM = 1.f / PPM;
 
-World::World(b2World& worldRef)
-	: physicsWorld(worldRef) // Gravity downward
-{
-	initParallax();
+// Obstacles in creation order; the index is the obstacle's textureIndex
+struct ObstacleDef {
+	float x, y;
+	bool onlyGround;
+	float width, height;
+	const char* texture;
+};
 
-	// Create ALL obstacles here (from the second / latest version)
-	createObstacle(400, 568 + 210, true, 170, 190, "Assets/Obstacles/Untitled-2.png"); //0
-	createObstacle(1000, 470 + 235, false, 300, 200, "Assets/Obstacles/foull car.png"); //1
+static const ObstacleDef kObstacles[] = {
+	{ 400, 568 + 210, true, 170, 190, "Assets/Obstacles/Untitled-2.png" }, //0
+	{ 1000, 470 + 235, false, 300, 200, "Assets/Obstacles/foull car.png" }, //1
 
-	createObstacle(1800, 620 + 235, false, 180, 30, "Assets/Obstacles/Closed_sewers_cap.png"); //2
+	{ 1800, 620 + 235, false, 180, 30, "Assets/Obstacles/Closed_sewers_cap.png" }, //2
 
+	{ 2900, 620 + 230, false, 110, 35, "Assets/Obstacles/sewers_cap1.png" }, //3
 
-	createObstacle(2900, 620 + 230, false, 110, 35, "Assets/Obstacles/sewers_cap1.png"); //3
+	{ 2910, 620 + 200, false, 350, 200, "Assets/Obstacles/sewers.png" }, //4
 
-	createObstacle(2910, 620 + 200, false, 350, 200, "Assets/Obstacles/sewers.png"); //4
+	{ 3800, 600 + 170, false, 250 * 1.1f, 170 * 1.2f, "Assets/Obstacles/grocery.png" }, //5
 
-	createObstacle(3800, 600 + 170, false, 250 * 1.1f, 170 * 1.2f, "Assets/Obstacles/grocery.png"); //5
-
-	createObstacle(4825, 0 + 210, false, 75 / 3, 200 / 3, "Assets/Obstacles/the shit.png"); //6
+	{ 4825, 0 + 210, false, 75 / 3, 200 / 3, "Assets/Obstacles/the shit.png" }, //6
 
 	//bird
-	createObstacle(4800, 0 + 210, false, 150, 100, "Assets/Obstacles/Bird1.png"); //7
-	createObstacle(4700, 600 + 210, false, 600, 100, "Assets/Obstacles/Untitled-3.png"); //8
+	{ 4800, 0 + 210, false, 150, 100, "Assets/Obstacles/Bird1.png" }, //7
+	{ 4700, 600 + 210, false, 600, 100, "Assets/Obstacles/Untitled-3.png" }, //8
 
-	createObstacle(6000, 640 + 170, false, 220, 220, "Assets/Obstacles/doggie.png"); //9
+	{ 6000, 640 + 170, false, 220, 220, "Assets/Obstacles/doggie.png" }, //9
 
-	createObstacle(7200, -300 + 210, false, 250, 150, "Assets/Obstacles/man falling.png"); //10
-	createObstacle(7200, 600 + 210, false, 400, 100, "Assets/Obstacles/Untitled-3.png"); //11
+	{ 7200, -300 + 210, false, 250, 150, "Assets/Obstacles/man falling.png" }, //10
+	{ 7200, 600 + 210, false, 400, 100, "Assets/Obstacles/Untitled-3.png" }, //11
 
 
-	createObstacle(630, 580 + 210, true, 150, 160, "Assets/Obstacles/trash.png"); //12
-	createObstacle(520, 595 + 210, true, 140, 155, "Assets/Obstacles/trash-1.png"); //13
+	{ 630, 580 + 210, true, 150, 160, "Assets/Obstacles/trash.png" }, //12
+	{ 520, 595 + 210, true, 140, 155, "Assets/Obstacles/trash-1.png" }, //13
 
 
 	/////Obstacles for only dicoration (the player does not interact with them)
-	createObstacle(680, 645 + 210, true, 40, 45, "Assets/Obstacles/no cola.png");
-	createObstacle(-470, 510 + 210, true, 440, 240, "Assets/Obstacles/bus.png");
-	createObstacle(-640, 560 + 210, true, 130, 130, "Assets/Obstacles/trash.png");
+	{ 680, 645 + 210, true, 40, 45, "Assets/Obstacles/no cola.png" },
+	{ -470, 510 + 210, true, 440, 240, "Assets/Obstacles/bus.png" },
+	{ -640, 560 + 210, true, 130, 130, "Assets/Obstacles/trash.png" },
+};
 
-	// Load doggie angry texture (optional, non-fatal)
-	if (!m_doggieAngryTexture.loadFromFile("Assets/Obstacles/doggieangry.png")) {
-		std::cerr << "Warning: failed to load doggieangry.png (optional)\n";
-	}
+static const char* const kDoggieAngryTexture = "Assets/Obstacles/doggieangry.png";
+static const char* const kManFellTexture = "Assets/Obstacles/man fell no effects.png";
 
-	// Load second frame for man-fall (frame2: man fell no effects)
-	if (!m_manFellFrame2.loadFromFile("Assets/Obstacles/man fell no effects.png")) {
-		std::cerr << "Warning: failed to load man fell no effects.png (optional)\n";
-	}
-
-	// Sewers cap animation setup (textureIndex ==3)
-	std::vector<std::string> sewerFrames = {
+static const char* const kSewerFrames[] = {
 	"Assets/Obstacles/sewers_cap1.png",
 	"Assets/Obstacles/sewers_cap2.png",
 	"Assets/Obstacles/sewers_cap3.png",
@@ -65,24 +64,88 @@ World::World(b2World& worldRef)
 	"Assets/Obstacles/sewers_cap6.png",
 	"Assets/Obstacles/sewers_cap7.png",
 	"Assets/Obstacles/sewers_cap8.png"
-	};
-	m_sewersAnim.AddClip("open", sewerFrames, 0.06f, /*loop=*/false);
-	m_sewersAnim.SetClip("open", true); // start on frame0
+};
+
+static const char* const kBirdFrames[] = {
+	"Assets/Obstacles/Bird1.png",
+	"Assets/Obstacles/Bird2.png",
+	"Assets/Obstacles/Bird3.png"
+};
+
+// Animated frames are baked down to these on-screen scales (see TextureBaker)
+static constexpr float kSewerDrawScale = 0.7f;
+static constexpr float kBirdDrawScale = 0.4f;
+
+static std::string parallaxLayerPath(int layer)
+{
+	return "Assets/Parallax/" + std::to_string(layer + 1) + ".png";
+}
+
+void World::QueueAssets(AsyncLoader& loader)
+{
+	for (int i = 0; i < PARALLAX_LAYER_COUNT; i++)
+	{
+		// The image stays resident too: initParallax analyses its alpha
+		loader.QueueTexture(parallaxLayerPath(i), false, /*repeated=*/true, /*keepImage=*/true);
+	}
+	for (const ObstacleDef& def : kObstacles)
+		loader.QueueTexture(def.texture);
+	loader.QueueTexture(kDoggieAngryTexture);
+	loader.QueueTexture(kManFellTexture);
+	const TextureBaker& baker = TextureBaker::Shared();
+	for (const char* frame : kSewerFrames)
+		loader.QueueImage(frame, baker.BakeScale(kSewerDrawScale));
+	for (const char* frame : kBirdFrames)
+		loader.QueueImage(frame, baker.BakeScale(kBirdDrawScale));
+}
+
+World::World(b2World& worldRef)
+	: physicsWorld(worldRef) // Gravity downward
+{
+	initParallax();
+
+	// Create ALL obstacles here (from the second / latest version)
+	for (const ObstacleDef& def : kObstacles)
+		createObstacle(def.x, def.y, def.onlyGround, def.width, def.height, def.texture);
+
+	// Load doggie angry texture (optional, non-fatal)
+	m_doggieAngryTexture = ResourceCache::Shared().GetTexture(kDoggieAngryTexture);
+	if (!m_doggieAngryTexture) {
+		std::cerr << "Warning: failed to load doggieangry.png (optional)\n";
+	}
+
+	// Load second frame for man-fall (frame2: man fell no effects)
+	m_manFellFrame2 = ResourceCache::Shared().GetTexture(kManFellTexture);
+	if (!m_manFellFrame2) {
+		std::cerr << "Warning: failed to load man fell no effects.png (optional)\n";
+	}
+
+	// Sewers cap animation setup (textureIndex ==3)
+	std::vector<std::string> sewerFrames(std::begin(kSewerFrames), std::end(kSewerFrames));
+	const TextureBaker& baker = TextureBaker::Shared();
+	const Animation::ClipId sewerOpen = m_sewersAnim.AddClip("open", sewerFrames, 0.06f, /*loop=*/false,
+		baker.BakeScale(kSewerDrawScale));
+	m_sewersAnim.SetClip(sewerOpen, true); // start on frame0
 
 	// Find the obstacle that uses sewers_cap1.png
 	Obstacle* cap = getObstacleByTexture(3);
 
 	if (cap)
 	{
+		cap->hidden = true;
 		m_sewersBasePos = cap->shape.getPosition();
 		m_sewersSprite.setPosition(m_sewersBasePos);
 	}
 
 	m_sewersAnim.BindSprite(&m_sewersSprite);
-	m_sewersSprite.setScale(0.7f, 0.7f);
+	m_sewersSprite.setScale(baker.SpriteScale(kSewerDrawScale), baker.SpriteScale(kSewerDrawScale));
+
+	// Slide the cap to the right on every frame change of the opening clip
+	m_sewersAnim.SetFrameCallback(sewerOpen, [this](std::size_t) {
+		m_sewersSprite.move(SEWER_STEP_X, 0.f);
+	});
 
 	m_sewersPlaying = false;
-	m_sewersLastFrame = -1;
 
 	m_sewerGameOverPending = false;
 	m_sewerGameOverTimer = 0.f;
@@ -90,21 +153,18 @@ World::World(b2World& worldRef)
 
 	// 🐦 Bird animation setup
 	// Bird frames (your3 PNGs)
-	std::vector<std::string> birdFrames = {
-	"Assets/Obstacles/Bird1.png",
-	"Assets/Obstacles/Bird2.png",
-	"Assets/Obstacles/Bird3.png"
-	};
+	std::vector<std::string> birdFrames(std::begin(kBirdFrames), std::end(kBirdFrames));
 
 	// Create a looping clip called "fly"
-	m_birdAnim.AddClip("fly", birdFrames, 0.08f, true);
-	m_birdAnim.SetClip("fly", true);
+	const Animation::ClipId birdFly = m_birdAnim.AddClip("fly", birdFrames, 0.08f, true, baker.BakeScale(kBirdDrawScale));
+	m_birdAnim.SetClip(birdFly, true);
 
 	// Find the obstacle that uses Bird1.png
 	Obstacle* birdObs = getObstacleByTexture(7); // Bird1 index in this file
 
 	if (birdObs)
 	{
+		birdObs->hidden = true;
 		// Starting position for the bird patrol
 		m_birdStartPos = birdObs->shape.getPosition();
 		m_birdSprite.setPosition(m_birdStartPos);
@@ -120,7 +180,7 @@ World::World(b2World& worldRef)
 	m_birdAnim.BindSprite(&m_birdSprite);
 
 	// Optional: make the bird smaller
-	m_birdSprite.setScale(0.4f, 0.4f);
+	m_birdSprite.setScale(baker.SpriteScale(kBirdDrawScale), baker.SpriteScale(kBirdDrawScale));
 
 	// Patrol settings (left/right limits around the start position)
 	m_birdMinX = m_birdStartPos.x - 250.f; // left limit
@@ -130,21 +190,29 @@ World::World(b2World& worldRef)
 	m_birdGoingRight = true;
 	m_birdAnim.SetFacingRight(true);
 
+	// The poop only shows once the bird drops it
+	if (Obstacle* poop = getObstacleByTexture(6))
+		poop->hidden = true;
+
+	bakeStaticObstacles();
 }
 
 
 void World::createObstacle(float x, float y, bool onlyGround, float scaleX, float scaleY, const std::string& textureFile)
 {
-	// Load texture and store it
-	obstacleTextures.emplace_back();
-	if (!obstacleTextures.back().loadFromFile(textureFile))
+	// Props reusing an image (trash, road strips) share one texture
+	std::shared_ptr<const sf::Texture> texture = ResourceCache::Shared().GetTexture(textureFile);
+	if (!texture)
+	{
 		std::cerr << "Failed to load texture: " << textureFile << std::endl;
-	obstacleTextures.back().setRepeated(false);
+		texture = std::make_shared<const sf::Texture>();
+	}
+	obstacleTextures.push_back(texture);
 
 	// keep track of filename for substring searches
 	obstacleTextureFiles.push_back(textureFile);
 
-	sf::Vector2u texSize = obstacleTextures.back().getSize();
+	sf::Vector2u texSize = texture->getSize();
 
 	// -------- BOX2D BODY --------
 	b2BodyDef bodyDef;
@@ -170,7 +238,7 @@ void World::createObstacle(float x, float y, bool onlyGround, float scaleX, floa
 	sf::RectangleShape shape(sf::Vector2f(scaleX, scaleY));
 	shape.setOrigin(scaleX / 2.f, scaleY / 2.f);
 	shape.setPosition(x, y);
-	shape.setTexture(&obstacleTextures.back());
+	shape.setTexture(texture.get());
 	shape.setTextureRect(sf::IntRect(0, 0, static_cast<int>(texSize.x), static_cast<int>(texSize.y)));
 
 	// Store obstacle with texture index
@@ -196,7 +264,7 @@ void World::resetObstacle(Obstacle& o)
 	if (!o.body) return;
 
 	// Restore body transform, type and velocities
-	o.body->SetType(o.startType);
+	setBodyType(o, o.startType);
 	o.body->SetTransform(o.startPosB2, o.startAngle);
 	o.body->SetLinearVelocity(b2Vec2_zero);
 	o.body->SetAngularVelocity(0.f);
@@ -218,7 +286,7 @@ void World::resetObstacle(Obstacle& o)
 	if (o.textureIndex == 10)
 	{
 		if (o.textureIndex >= 0 && o.textureIndex < obstacleTextures.size()) {
-			sf::Texture& tex = obstacleTextures[o.textureIndex];
+			const sf::Texture& tex = *obstacleTextures[o.textureIndex];
 			o.shape.setTexture(&tex);
 			sf::Vector2u texSize = tex.getSize();
 			o.shape.setTextureRect(sf::IntRect(0, 0, static_cast<int>(texSize.x), static_cast<int>(texSize.y)));
@@ -238,7 +306,6 @@ void World::ResetWorld()
 
 	// 🔁 reset sewer animation state
 	m_sewersPlaying = false;
-	m_sewersLastFrame = -1;
 	m_sewersAnim.Reset();
 	m_sewersSprite.setPosition(m_sewersBasePos);
 
@@ -249,6 +316,8 @@ void World::ResetWorld()
 	m_birdAnim.Reset();
 
 	m_poopDropped = false;
+	if (Obstacle* poop = getObstacleByTexture(6))
+		poop->hidden = true;
 
 	// Restore any player fixtures we modified when sewer cap triggered
 	for (auto& pair : m_modifiedPlayerFixtures)
@@ -270,6 +339,9 @@ void World::ResetWorld()
 
 	// Reset man-fell landing state
 	m_manFellLanded = false;
+
+	// Bodies are static again; put anything that fell back into the batch
+	bakeStaticObstacles();
 }
 World::Obstacle* World::getObstacleByTexture(size_t textureIndex)
 {
@@ -315,20 +387,7 @@ void World::update(float dt, const sf::Vector2f& camPos)
 	// ✅ Animate sewer cap + move to the right on each frame change
 	if (m_sewersPlaying)
 	{
-		m_sewersAnim.Update(dt);
-
-		// Read current frame index from the Animation class
-		int currentFrame = static_cast<int>(m_sewersAnim.CurrentFrameIndex());
-
-		// If the frame changed since last update → move sprite
-		if (currentFrame != m_sewersLastFrame)
-		{
-			m_sewersLastFrame = currentFrame;
-			//How much to move to the right per frame (tweak this)
-			float stepX = 60.f;
-			float stepY = 0.f;
-			m_sewersSprite.move(stepX, stepY);
-		}
+		m_sewersAnim.Update(dt); // frame callback moves the sprite
 	}
 
 	// 🐦 Update bird animation + left/right movement
@@ -414,9 +473,9 @@ void World::checkCollision(const sf::RectangleShape& playerShape, bool playerCal
 				if (!m_sewersPlaying)
 				{
 					m_sewersPlaying = true;
-					m_sewersLastFrame = -1; // so first frame movement works
 					m_sewersAnim.Reset(); // reset time & frame index to0
 					m_sewersSprite.setPosition(m_sewersBasePos); // start from base
+					m_sewersSprite.move(SEWER_STEP_X, 0.f); // step for the first frame; later ones come from the frame callback
 				}
 
 				// If we haven't already applied the mask change for player fixtures, do it now and start timer
@@ -446,7 +505,7 @@ void World::checkCollision(const sf::RectangleShape& playerShape, bool playerCal
 			}
 			else if (obj.textureIndex == 7)
 			{
-				obj.body->SetType(b2_dynamicBody);
+				setBodyType(obj, b2_dynamicBody);
 				obj.shape.setFillColor(sf::Color::Blue);
 			}
 			else if (obj.textureIndex == 8)
@@ -483,11 +542,12 @@ void World::checkCollision(const sf::RectangleShape& playerShape, bool playerCal
 						}
 
 						//3) Turn into dynamic so it FALLS
-						fallingObj->body->SetType(b2_dynamicBody);
+						setBodyType(*fallingObj, b2_dynamicBody);
 						fallingObj->body->SetAwake(true);
 
 						//4) Remember that we already dropped it
 						m_poopDropped = true;
+						fallingObj->hidden = false;
 					}
 				}
 			}
@@ -509,7 +569,7 @@ void World::checkCollision(const sf::RectangleShape& playerShape, bool playerCal
 						filter.maskBits |= CATEGORY_GROUND;
 						f->SetFilterData(filter);
 					}
-					fallingObj->body->SetType(b2_dynamicBody);
+					setBodyType(*fallingObj, b2_dynamicBody);
 					fallingObj->body->SetAwake(true);
 				}
 			}
@@ -528,10 +588,11 @@ void World::checkCollision(const sf::RectangleShape& playerShape, bool playerCal
 			// DOGGIE angry swap: index9 -> if player is colliding and playerCalm (walking/idle) then use angry texture
 			if (obj.textureIndex == 9)
 			{
-				if (playerCalm && m_doggieAngryTexture.getSize().x > 0)
+				if (playerCalm && m_doggieAngryTexture && m_doggieAngryTexture->getSize().x > 0)
 				{
-					obj.shape.setTexture(&m_doggieAngryTexture);
-					sf::Vector2u ts = m_doggieAngryTexture.getSize();
+					unbake(obj); // the batch holds the calm texture
+					obj.shape.setTexture(m_doggieAngryTexture.get());
+					sf::Vector2u ts = m_doggieAngryTexture->getSize();
 					obj.shape.setTextureRect(sf::IntRect(0, 0, static_cast<int>(ts.x), static_cast<int>(ts.y)));
 
 					// If the dog becomes angry while colliding with the player -> trigger game over
@@ -556,7 +617,7 @@ void World::checkCollision(const sf::RectangleShape& playerShape, bool playerCal
 			{
 				if (obj.textureIndex >= 0 && obj.textureIndex < obstacleTextures.size())
 				{
-					sf::Texture& tex = obstacleTextures[obj.textureIndex];
+					const sf::Texture& tex = *obstacleTextures[obj.textureIndex];
 					obj.shape.setTexture(&tex);
 					sf::Vector2u texSize = tex.getSize();
 					obj.shape.setTextureRect(sf::IntRect(0, 0, static_cast<int>(texSize.x), static_cast<int>(texSize.y)));
@@ -575,6 +636,7 @@ void World::checkCollision(const sf::RectangleShape& playerShape, bool playerCal
 			{
 				resetObstacle(*fallingObj);
 				m_poopDropped = false; // allow future drops again
+				fallingObj->hidden = true;
 			}
 		}
 	}
@@ -587,10 +649,10 @@ void World::checkCollision(const sf::RectangleShape& playerShape, bool playerCal
 			if (IsTouchingGround(man->body, CATEGORY_GROUND))
 			{
 				// Swap to frame2 if we have that texture
-				if (m_manFellFrame2.getSize().x > 0)
+				if (m_manFellFrame2 && m_manFellFrame2->getSize().x > 0)
 				{
-					man->shape.setTexture(&m_manFellFrame2);
-					sf::Vector2u ts = m_manFellFrame2.getSize();
+					man->shape.setTexture(m_manFellFrame2.get());
+					sf::Vector2u ts = m_manFellFrame2->getSize();
 					man->shape.setTextureRect(sf::IntRect(0, 0, static_cast<int>(ts.x), static_cast<int>(ts.y)));
 				}
 
@@ -619,42 +681,83 @@ int World::findObstacleByTextureSubstring(const std::string& substr) const
 
 b2Vec2 World::getObstacleBodyPosition(int index) const
 {
-	if (index < 0 || index >= static_cast<int>(obstacles.size())) return b2Vec2(0.f, 0.f);
-	b2Body* b = obstacles[index].body;
+	const b2Body* b = getObstacleBody(index);
 	if (!b) return b2Vec2(0.f, 0.f);
 	return b->GetPosition();
 }
 
+const b2Body* World::getObstacleBody(int index) const
+{
+	if (index < 0 || index >= static_cast<int>(obstacles.size())) return nullptr;
+	return obstacles[index].body;
+}
+
 int World::getLastCollidedObstacleIndex() const
 {
 	return lastCollidedObstacleIndex;
 }
 
-void World::draw(sf::RenderWindow& window)
+// ======================================================================
+// STATIC GEOMETRY
+// ======================================================================
+bool World::isBakeable(const Obstacle& o) const
 {
-	// Draw background layers
-	drawParallaxBackground(window);
+	// Props that later move or change look leave the batch where that happens
+	// (setBodyType, unbake); hidden ones have nothing to bake
+	return o.body && o.body->GetType() == b2_staticBody && !o.hidden;
+}
 
-	// Draw obstacles behind player if needed
-	for (auto& obj : obstacles)
+void World::bakeStaticObstacles()
+{
+	m_staticGeometry.Clear();
+	for (size_t i = 0; i < obstacles.size(); ++i)
 	{
+		Obstacle& o = obstacles[i];
+		o.baked = isBakeable(o);
+		if (o.baked)
+			m_staticGeometry.Add(i, o.shape);
+	}
+}
 
-		if (obj.textureIndex == 3) // sewer cap
-			continue;
-		if (obj.textureIndex == 7) // bird
-			continue;
-		if (obj.textureIndex == 6 && !m_poopDropped)
-			continue; // 💩 don't draw poop before it drops
+void World::unbake(Obstacle& o)
+{
+	if (!o.baked) return;
+	o.baked = false;
+	m_staticGeometry.Remove(static_cast<size_t>(&o - obstacles.data()));
+}
 
+void World::setBodyType(Obstacle& o, b2BodyType type)
+{
+	if (type != b2_staticBody) unbake(o);
+	o.body->SetType(type);
+}
 
+void World::draw(Renderer& renderer)
+{
+	// Background layers are drawn by Game::render via drawParallaxBackground()
+	renderer.BeginPass(RenderPass::Obstacles);
 
-		window.draw(obj.shape);
+	const sf::View& view = renderer.GetView();
+	const sf::FloatRect visible(view.getCenter() - view.getSize() * 0.5f, view.getSize());
 
+	// Draw obstacles behind player if needed. Baked props go in the stretches
+	// between the shapes drawn here, so everything keeps its creation order.
+	size_t bakedFrom = 0;
+	for (size_t i = 0; i < obstacles.size(); ++i)
+	{
+		Obstacle& obj = obstacles[i];
+		if (obj.baked || obj.hidden) // sewer cap and bird are sprites; 💩 not drawn before it drops
+			continue;
+
+		m_staticGeometry.Draw(renderer, visible, bakedFrom, i);
+		renderer.Draw(obj.shape);
+		bakedFrom = i + 1;
 	}
+	m_staticGeometry.Draw(renderer, visible, bakedFrom, obstacles.size());
 	// Draw the sewer cap sprite (static at first, animated after collision)
-	window.draw(m_sewersSprite);
+	renderer.Draw(m_sewersSprite);
 	// 🐦 Bird sprite
-	window.draw(m_birdSprite);
+	renderer.Draw(m_birdSprite);
 
 
 
@@ -663,7 +766,7 @@ void World::draw(sf::RenderWindow& window)
 	// Player will be drawn in Game::render after this
 
 	// Foreground layers will be drawn after the player
-	// drawParallaxForeground(window); // <-- called in Game::render AFTER player
+	// drawParallaxForeground(renderer); // <-- called in Game::render AFTER player
 }
 
 // ======================================================================
@@ -672,7 +775,7 @@ void World::draw(sf::RenderWindow& window)
 void World::initParallax()
 {
 	parallaxLayers.clear();
-	parallaxLayers.resize(14);
+	parallaxLayers.resize(PARALLAX_LAYER_COUNT);
 
 	// -----------------------------
 	// CENTRALIZED PARALLAX CONFIG
@@ -685,7 +788,7 @@ void World::initParallax()
 	};
 
 	// BACK → FRONT (14 layers)
-	const LayerConfig config[14] =
+	const LayerConfig config[PARALLAX_LAYER_COUNT] =
 	{
 		//speedx/y y axis pos, scale
 		{0.0f,0.00f,0.0f,1.00f}, // layer1 (very far)
@@ -709,16 +812,25 @@ void World::initParallax()
 		{0.0f,0.0f,300.0f,1.0f}, // layer14 (All Props)
 	};
 
-	for (int i = 0; i < 14; i++)
+	for (int i = 0; i < PARALLAX_LAYER_COUNT; i++)
 	{
-		std::string path = "Assets/Parallax/" + std::to_string(i + 1) + ".png";
+		std::string path = parallaxLayerPath(i);
 
-		if (!parallaxLayers[i].texture.loadFromFile(path))
+		// Decode once: the image feeds both the texture and the alpha analysis.
+		// Both are usually already resident from the background loader.
+		std::shared_ptr<const sf::Image> image = ResourceCache::Shared().GetImage(path);
+		parallaxLayers[i].texture = image ? ResourceCache::Shared().GetTexture(path, false, /*repeated=*/true) : nullptr;
+		if (!parallaxLayers[i].texture)
+		{
 			std::cerr << "FAILED TO LOAD PARALLAX: " << path << "\n";
+			parallaxLayers[i].texture = std::make_shared<const sf::Texture>();
+		}
+		else
+		{
+			parallaxLayers[i].tiles.Build(*image);
+		}
 
-		parallaxLayers[i].texture.setRepeated(true);
-
-		parallaxLayers[i].sprite.setTexture(parallaxLayers[i].texture);
+		parallaxLayers[i].sprite.setTexture(*parallaxLayers[i].texture);
 		parallaxLayers[i].sprite.setTextureRect(sf::IntRect(0, 0, 1920, 1080));
 
 		// Apply user-friendly controls
@@ -757,7 +869,7 @@ void World::updateParallax(const sf::Vector2f& camPos)
 				layer.baseXOffset += (cloudSpeed + 15.f) * dtc;
 
 			// wrap offset to avoid floating point overflow
-			float texW = layer.texture.getSize().x * layer.scale;
+			float texW = layer.texture->getSize().x * layer.scale;
 			if (layer.baseXOffset <= -texW) layer.baseXOffset += texW;
 			else if (layer.baseXOffset >= texW) layer.baseXOffset -= texW;
 
@@ -790,44 +902,153 @@ void World::updateParallax(const sf::Vector2f& camPos)
 }
 
 // ======================================================================
-// DRAW PARALLAX (HORIZONTAL WRAP ONLY)
+// DRAW PARALLAX (HORIZONTAL WRAP, TILED)
 // ======================================================================
 
+static void appendQuad(sf::VertexArray& va, const sf::FloatRect& r, const sf::IntRect& tex, const sf::Color& color)
+{
+	const float l = r.left, t = r.top, rr = r.left + r.width, b = r.top + r.height;
+	const float tl = static_cast<float>(tex.left), tt = static_cast<float>(tex.top);
+	const float tr = static_cast<float>(tex.left + tex.width), tb = static_cast<float>(tex.top + tex.height);
+
+	va.append(sf::Vertex({ l, t }, color, { tl, tt }));
+	va.append(sf::Vertex({ rr, t }, color, { tr, tt }));
+	va.append(sf::Vertex({ rr, b }, color, { tr, tb }));
+	va.append(sf::Vertex({ l, t }, color, { tl, tt }));
+	va.append(sf::Vertex({ rr, b }, color, { tr, tb }));
+	va.append(sf::Vertex({ l, b }, color, { tl, tb }));
+}
+
+// Each heat-map layer adds this much; brighter = more overdraw
+static const sf::Color kOverdrawHeat(28, 8, 2);
+
+// Walk all layers front to back once per frame: cull tiles outside the view,
+// skip tiles hidden behind opaque tiles of nearer layers, and batch the rest.
+void World::buildParallaxBatches(const sf::View& view)
+{
+	const sf::Vector2f viewSize = view.getSize();
+	const sf::FloatRect viewRect(view.getCenter().x - viewSize.x * 0.5f, view.getCenter().y - viewSize.y * 0.5f,
+		viewSize.x, viewSize.y);
+
+	m_parallaxCoverage.Reset(viewRect, 30.f);
+	m_parallaxOpaqueDrawn = m_parallaxBlendDrawn = m_parallaxOccluded = 0;
+
+	const bool naive = (m_parallaxView == ParallaxView::OverdrawNaive);
+	const sf::Color color = (m_parallaxView == ParallaxView::Normal) ? sf::Color::White : kOverdrawHeat;
+
+	for (size_t i = parallaxLayers.size(); i-- > 0;)
+	{
+		ParallaxLayer& layer = parallaxLayers[i];
+		layer.opaqueBatch.clear();
+		layer.blendBatch.clear();
+
+		const sf::Vector2u texSize = layer.texture->getSize();
+		float texW = texSize.x * layer.scale;
+		if (texW <= 0.f) continue; // safety
+
+		float baseX = std::fmod(layer.sprite.getPosition().x, texW);
+		if (baseX > 0) baseX -= texW;
+		float y = layer.sprite.getPosition().y;
+
+		int firstTile = static_cast<int>(std::floor((viewRect.left - baseX) / texW)) - 1;
+		int needed = static_cast<int>(std::ceil(viewRect.width / texW)) + 3;
+
+		for (int c = 0; c < needed; ++c)
+		{
+			const float ox = baseX + texW * (firstTile + c);
+
+			if (naive)
+			{
+				// What the untiled path used to draw: the whole layer, blended
+				const sf::FloatRect full(ox, y, texW, texSize.y * layer.scale);
+				if (full.intersects(viewRect))
+				{
+					appendQuad(layer.blendBatch, full, sf::IntRect(0, 0, texSize.x, texSize.y), color);
+					++m_parallaxBlendDrawn;
+				}
+				continue;
+			}
+
+			for (const ParallaxTile& tile : layer.tiles.Tiles())
+			{
+				const sf::FloatRect r(ox + tile.rect.left * layer.scale, y + tile.rect.top * layer.scale,
+					tile.rect.width * layer.scale, tile.rect.height * layer.scale);
+				if (!r.intersects(viewRect)) continue;
+
+				if (m_parallaxCoverage.IsHidden(r))
+				{
+					++m_parallaxOccluded;
+					continue;
+				}
+
+				if (tile.opaque)
+				{
+					appendQuad(layer.opaqueBatch, r, tile.rect, color);
+					m_parallaxCoverage.AddOccluder(r);
+					++m_parallaxOpaqueDrawn;
+				}
+				else
+				{
+					appendQuad(layer.blendBatch, r, tile.rect, color);
+					++m_parallaxBlendDrawn;
+				}
+			}
+		}
+	}
+}
+
 // Draw background layers (0 →11)
-void World::drawParallaxBackground(sf::RenderWindow& window)
+void World::drawParallaxBackground(Renderer& renderer)
 {
+	renderer.BeginPass(RenderPass::Background);
+	buildParallaxBatches(renderer.GetView());
 	for (size_t i = 0; i < 12 && i < parallaxLayers.size(); ++i) // layers0–11
-		drawLayer(window, parallaxLayers[i]);
+		drawLayer(renderer, parallaxLayers[i]);
 }
 
-// Draw foreground layers (12 → end)
-void World::drawParallaxForeground(sf::RenderWindow& window)
+// Draw foreground layers (12 → end); batches were built with the background
+void World::drawParallaxForeground(Renderer& renderer)
 {
+	renderer.BeginPass(RenderPass::Foreground);
 	for (size_t i = 12; i < parallaxLayers.size(); ++i)
-		drawLayer(window, parallaxLayers[i]);
+		drawLayer(renderer, parallaxLayers[i]);
 }
 
-// Helper to draw a single layer (wraps horizontally)
-void World::drawLayer(sf::RenderWindow& window, ParallaxLayer& layer)
+// Helper to draw a single layer: opaque tiles without blending, then the rest
+void World::drawLayer(Renderer& renderer, ParallaxLayer& layer)
 {
-	sf::View view = window.getView();
-	float viewW = view.getSize().x;
-	float viewLeft = view.getCenter().x - viewW * 0.5f;
-
-	float texW = layer.texture.getSize().x * layer.scale;
-	if (texW <= 0.f) return; // safety
-
-	float baseX = std::fmod(layer.sprite.getPosition().x, texW);
-	if (baseX > 0) baseX -= texW;
-	float y = layer.sprite.getPosition().y;
-
-	int firstTile = static_cast<int>(std::floor((viewLeft - baseX) / texW)) - 1;
-	int needed = static_cast<int>(std::ceil(viewW / texW)) + 3;
+	sf::RenderStates states;
+	if (m_parallaxView == ParallaxView::Normal)
+	{
+		states.texture = layer.texture.get();
+		states.blendMode = sf::BlendNone;
+		renderer.Draw(layer.opaqueBatch, states);
+		states.blendMode = sf::BlendAlpha;
+		renderer.Draw(layer.blendBatch, states);
+	}
+	else
+	{
+		states.blendMode = sf::BlendAdd;
+		renderer.Draw(layer.opaqueBatch, states);
+		renderer.Draw(layer.blendBatch, states);
+	}
+}
 
-	for (int i = 0; i < needed; ++i)
+void World::cycleParallaxView()
+{
+	switch (m_parallaxView)
 	{
-		sf::Sprite copy = layer.sprite;
-		copy.setPosition(baseX + texW * (firstTile + i), y);
-		window.draw(copy);
+	case ParallaxView::Normal: m_parallaxView = ParallaxView::OverdrawOptimized; break;
+	case ParallaxView::OverdrawOptimized: m_parallaxView = ParallaxView::OverdrawNaive; break;
+	default: m_parallaxView = ParallaxView::Normal; break;
 	}
-}
\ No newline at end of file
+}
+
+std::string World::parallaxSummary() const
+{
+	static const char* names[] = { "normal", "overdraw (tiled)", "overdraw (full layers)" };
+	return std::string("Parallax [") + names[static_cast<int>(m_parallaxView)] + "] tiles: "
+		+ std::to_string(m_parallaxOpaqueDrawn) + " opaque, "
+		+ std::to_string(m_parallaxBlendDrawn) + " blended, "
+		+ std::to_string(m_parallaxOccluded) + " occluded";
+}
@@ -4,13 +4,25 @@
 #include <vector>
 #include <string>
 #include <utility>
+#include <memory>
 #include "Animation.h" 
+#include "Renderer.h"
+#include "ParallaxTiles.h"
+#include "StaticGeometry.h"
+
+class AsyncLoader;
 
 class World
 {
 public:
 	World(b2World& worldRef);
 
+	// Queue every image the constructor loads, so it can be decoded in the
+	// background before the World is built
+	static void QueueAssets(AsyncLoader& loader);
+
+	static constexpr int PARALLAX_LAYER_COUNT = 14;
+
 	// Collision categories
 	static constexpr uint16 CATEGORY_PLAYER = 0x0001;
 	static constexpr uint16 CATEGORY_GROUND = 0x0002;
@@ -18,15 +30,23 @@ public:
 	static constexpr uint16 CATEGORY_SENSOR = 0x0008;
 
 	struct ParallaxLayer {
-		sf::Texture texture;
+		std::shared_ptr<const sf::Texture> texture; // repeated, from ResourceCache
 		sf::Sprite  sprite;
 		float baseYOffset = 0.f;
 		float baseXOffset = 0.f;
 		float scale = 1.f;
 		float speedX = 0.f;
 		float speedY = 0.f;
+
+		// Alpha-trimmed tiles and the per-frame batches built from them
+		ParallaxTileSet tiles;
+		sf::VertexArray opaqueBatch{ sf::Triangles };
+		sf::VertexArray blendBatch{ sf::Triangles };
 	};
 
+	// Debug visualisation of parallax fill cost
+	enum class ParallaxView { Normal, OverdrawOptimized, OverdrawNaive };
+
 	struct Obstacle {
 		b2Body* body;
 		sf::RectangleShape shape;
@@ -40,6 +60,11 @@ public:
 		uint16       initialCategoryBits = 0;
 		uint16       initialMaskBits = 0;
 
+		// Drawn as a sprite instead (sewer cap, bird) or not shown yet (poop)
+		bool         hidden = false;
+		// Drawn from the static geometry batch instead of its own shape
+		bool         baked = false;
+
 		Obstacle(b2Body* b, const sf::RectangleShape& s, bool og, size_t texIdx)
 			: body(b), shape(s), onlyGround(og), textureIndex(texIdx) {
 		}
@@ -49,18 +74,24 @@ public:
 	// PUBLIC API
 	// ---------------------------------------------------------------------
 	void update(float dt, const sf::Vector2f& camPos);
-	void draw(sf::RenderWindow& window);
+	void draw(Renderer& renderer);
 	// Accept whether the player is calm (walking or idle) so obstacles may react
 	void checkCollision(const sf::RectangleShape& playerShape, bool playerCalm = false);
 
-	void drawParallaxBackground(sf::RenderWindow& window);
-	void drawParallaxForeground(sf::RenderWindow& window);
-	void drawLayer(sf::RenderWindow& window, ParallaxLayer& layer);
+	void drawParallaxBackground(Renderer& renderer);
+	void drawParallaxForeground(Renderer& renderer);
+	void drawLayer(Renderer& renderer, ParallaxLayer& layer);
+
+	// Normal -> overdraw heat-map (tiled) -> overdraw heat-map (full layers)
+	void cycleParallaxView();
+	ParallaxView getParallaxView() const { return m_parallaxView; }
+	std::string parallaxSummary() const;
 
 	void createObstacle(float x, float y, bool onlyGround, float sx, float sy, const std::string& texFile);
 
 	int   findObstacleByTextureSubstring(const std::string& substr) const;
 	b2Vec2 getObstacleBodyPosition(int index) const;
+	const b2Body* getObstacleBody(int index) const; // nullptr if out of range
 	int   getLastCollidedObstacleIndex() const;
 	Obstacle* getObstacleByTexture(size_t textureIndex);
 
@@ -80,19 +111,34 @@ private:
 	void updateParallax(const sf::Vector2f& camPos);
 	bool  parallaxAligned = false;
 	float parallaxYOffset = 0.f;
+	void buildParallaxBatches(const sf::View& view);
+
+	CoverageGrid m_parallaxCoverage;
+	ParallaxView m_parallaxView = ParallaxView::Normal;
+	size_t m_parallaxOpaqueDrawn = 0;
+	size_t m_parallaxBlendDrawn = 0;
+	size_t m_parallaxOccluded = 0;
 
 	// Obstacles
 	std::vector<Obstacle> obstacles;
-	std::vector<sf::Texture> obstacleTextures;
+	std::vector<std::shared_ptr<const sf::Texture>> obstacleTextures; // shared through ResourceCache, never null
 	std::vector<std::string> obstacleTextureFiles;
 
+	// Static props baked into per-section vertex buffers
+	StaticGeometry m_staticGeometry;
+	bool isBakeable(const Obstacle& o) const;
+	void bakeStaticObstacles();
+	void unbake(Obstacle& o);
+	// Every body type change goes through here so a prop that starts moving leaves the batch
+	void setBodyType(Obstacle& o, b2BodyType type);
+
 
 	// 🟡 Sewer-cap animation
 	Animation   m_sewersAnim;
 	sf::Sprite  m_sewersSprite;
 	bool        m_sewersPlaying = false;
 
-	int         m_sewersLastFrame = -1;
+	static constexpr float SEWER_STEP_X = 60.f; // cap slides right this far per animation frame
 	sf::Vector2f m_sewersBasePos;   // where the cap starts before moving
 
 
@@ -107,10 +153,10 @@ private:
 	bool m_poopDropped = false;
 
 	// Doggie angry texture (optional asset)
-	sf::Texture m_doggieAngryTexture;
+	std::shared_ptr<const sf::Texture> m_doggieAngryTexture;
 
 	// Man-fall landing: second-frame texture and landed state
-	sf::Texture m_manFellFrame2;
+	std::shared_ptr<const sf::Texture> m_manFellFrame2;
 	bool m_manFellLanded = false;
 
 	// Collision debug info
@@ -0,0 +1,130 @@
+// Builds Assets.pak from a directory tree.
+//
+//   AssetPacker <asset directory> <output.pak>
+//
+// Run it from the game's working directory (Jam/) so the stored names match
+// the paths the game asks for, e.g. "AssetPacker Assets Assets.pak" stores
+// Assets/Obstacles/bus.png as "assets/obstacles/bus.png".
+#include "../../Jam/AssetPackFormat.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace AssetPackFormat;
+
+struct SourceFile {
+    fs::path path;
+    std::string name;    // normalised
+    std::uint64_t hash = 0;
+    std::uint64_t size = 0;
+};
+
+static void writePadding(std::ofstream& out, std::uint64_t count)
+{
+    static const char zeros[BLOB_ALIGNMENT] = {};
+    while (count > 0) {
+        const std::uint64_t n = std::min<std::uint64_t>(count, sizeof(zeros));
+        out.write(zeros, static_cast<std::streamsize>(n));
+        count -= n;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3) {
+        std::cerr << "usage: AssetPacker <asset directory> <output.pak>\n";
+        return 1;
+    }
+    const fs::path root = argv[1];
+    const fs::path output = argv[2];
+
+    std::error_code ec;
+    if (!fs::is_directory(root, ec)) {
+        std::cerr << "error: not a directory: " << root.string() << "\n";
+        return 1;
+    }
+
+    std::vector<SourceFile> files;
+    for (const auto& item : fs::recursive_directory_iterator(root)) {
+        if (!item.is_regular_file()) continue;
+        SourceFile f;
+        f.path = item.path();
+        f.name = NormalizePath((root / fs::relative(item.path(), root)).generic_string());
+        f.hash = HashPath(f.name);
+        f.size = item.file_size();
+        files.push_back(std::move(f));
+    }
+
+    std::sort(files.begin(), files.end(), [](const SourceFile& a, const SourceFile& b) {
+        return a.hash != b.hash ? a.hash < b.hash : a.name < b.name;
+    });
+    for (std::size_t i = 1; i < files.size(); ++i) {
+        if (files[i].name == files[i - 1].name) {
+            // Only differs in case or separators; the game could not tell them apart
+            std::cerr << "error: " << files[i - 1].path.string() << " and " << files[i].path.string()
+                << " map to the same name " << files[i].name << "\n";
+            return 1;
+        }
+    }
+
+    // Layout: header, index, names, then aligned blobs
+    PackHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.entryCount = static_cast<std::uint32_t>(files.size());
+    header.blobAlignment = BLOB_ALIGNMENT;
+    header.namesOffset = sizeof(PackHeader) + files.size() * sizeof(PackEntry);
+
+    std::vector<PackEntry> entries(files.size());
+    std::string names;
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        entries[i].hash = files[i].hash;
+        entries[i].size = files[i].size;
+        entries[i].nameOffset = static_cast<std::uint32_t>(names.size());
+        entries[i].nameSize = static_cast<std::uint32_t>(files[i].name.size());
+        names += files[i].name;
+    }
+    header.namesSize = names.size();
+
+    std::uint64_t offset = AlignUp(header.namesOffset + header.namesSize, BLOB_ALIGNMENT);
+    for (PackEntry& e : entries) {
+        e.offset = offset;
+        offset = AlignUp(offset + e.size, BLOB_ALIGNMENT);
+    }
+
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "error: cannot write " << output.string() << "\n";
+        return 1;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(PackEntry)));
+    out.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    std::uint64_t written = header.namesOffset + header.namesSize;
+    std::vector<char> buffer;
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        writePadding(out, entries[i].offset - written);
+
+        std::ifstream in(files[i].path, std::ios::binary);
+        buffer.resize(static_cast<std::size_t>(files[i].size));
+        if (!in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+            std::cerr << "error: cannot read " << files[i].path.string() << "\n";
+            return 1;
+        }
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        written = entries[i].offset + entries[i].size;
+    }
+
+    if (!out.flush()) {
+        std::cerr << "error: write failed: " << output.string() << "\n";
+        return 1;
+    }
+    std::cout << "Packed " << files.size() << " files into " << output.string()
+        << " (" << written / 1024 << " KB)\n";
+    return 0;
+}